@@ -1,15 +1,39 @@
 #include <telemetry/TelemetryReader.h>
+#include <telemetry/MappedTelemetryReader.h>
+#include <telemetry/TelemetryRecorder.h>
+#include <telemetry/PacketWriter.h>
+#include <telemetry/PacketReader.h>
+#include <telemetry/Schema.h>
+#include <telemetry/Verify.h>
 #include <telemetry/TelemetryFormat.h>
 #include <telemetry/CRC.h>
+#include <telemetry/IoUring.h>
+#include <telemetry/BitStream.h>
+#include <telemetry/FloatXorCodec.h>
+#include <telemetry/Lz.h>
+#include <telemetry_sim/CompactFrameCodec.h>
+#include <telemetry_sim/FrameDecoder.h>
+#include <telemetry_sim/TelemetryFrame.h>
+#include <telemetry_sim/TelemetryFrameBatch.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <optional>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 namespace fs = std::filesystem;
@@ -44,6 +68,11 @@ static void write_header(std::ostream& out, std::uint16_t version, std::uint16_t
     write_u16_le(out, flags);
 }
 
+static std::vector<std::uint8_t> read_file_bytes(const fs::path& file) {
+    std::ifstream in(file, std::ios::binary);
+    return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
 static void write_crc(std::ostream& out, const std::uint32_t crc) {
     write_u32_le(out, crc);
 }
@@ -334,9 +363,1998 @@ static void test_zero_size_packet_rejected(TestResult& tr, const fs::path& dir,
     }
 }
 
-// ------------------------------
-// main()
-// ------------------------------
+static void test_crc_engines_match_reference(TestResult& tr) {
+    const std::string name = "crc_engines_match_bitwise_reference";
+
+    // CRC-32/BZIP2 check value (same polynomial, MSB-first, init/xorout 0xFFFFFFFF)
+    const std::string check = "123456789";
+    std::span<const std::uint8_t> check_bytes(reinterpret_cast<const std::uint8_t*>(check.data()), check.size());
+    if (telemetry::crc32(check_bytes) != 0xFC891918u) {
+        fail(tr, name, "check value mismatch for \"123456789\"");
+        return;
+    }
+
+    const telemetry::Crc32Engine engines[] = {
+        telemetry::Crc32Engine::Slice8,
+        telemetry::Crc32Engine::Slice16,
+        telemetry::Crc32Engine::Pclmul,
+    };
+
+    std::vector<std::uint8_t> data;
+    std::uint32_t state = 12345;
+    for (std::size_t len = 0; len <= 1100; len++) {
+        data.resize(len);
+        for (auto& b : data) {
+            state = state * 1103515245u + 12345u;
+            b = static_cast<std::uint8_t>(state >> 16);
+        }
+
+        std::uint32_t expected = telemetry::crc32(data, telemetry::Crc32Engine::Bitwise);
+        for (auto engine : engines) {
+            if (telemetry::crc32(data, engine) != expected) {
+                fail(tr, name, std::string(telemetry::to_string(engine)) +
+                               " mismatch at length " + std::to_string(len));
+                return;
+            }
+        }
+    }
+
+    pass(tr, name);
+}
+
+static void test_crc_incremental_and_combine(TestResult& tr) {
+    const std::string name = "crc_incremental_and_combine_match_one_shot";
+
+    std::vector<std::uint8_t> data(777);
+    for (std::size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<std::uint8_t>(i * 31 + 7);
+    }
+    std::span<const std::uint8_t> all(data);
+    const std::uint32_t expected = telemetry::crc32(all);
+
+    for (std::size_t split : {std::size_t{0}, std::size_t{1}, std::size_t{4}, std::size_t{100}, std::size_t{776}, data.size()}) {
+        auto head = all.first(split);
+        auto tail = all.subspan(split);
+
+        telemetry::Crc32 crc;
+        crc.update(head).update(tail);
+        if (crc.value() != expected) {
+            fail(tr, name, "incremental mismatch at split " + std::to_string(split));
+            return;
+        }
+
+        std::uint32_t combined = telemetry::crc32_combine(telemetry::crc32(head), telemetry::crc32(tail), tail.size());
+        if (combined != expected) {
+            fail(tr, name, "combine mismatch at split " + std::to_string(split));
+            return;
+        }
+    }
+
+    pass(tr, name);
+}
+
+static void test_batched_writes_match_single_writes(TestResult& tr, const fs::path& dir,
+                                                    telemetry::Logger& logger) {
+    const std::string name = "write_packets_matches_write_packet_bytes";
+    const fs::path single_file = dir / "single_writes.bin";
+    const fs::path batch_file = dir / "batch_writes.bin";
+
+    const std::vector<std::vector<std::uint8_t>> payloads = {
+        {0x01},
+        {0x10, 0x11, 0x12, 0x13},
+        std::vector<std::uint8_t>(300, 0x5A),
+    };
+
+    try {
+        {
+            telemetry::TelemetryRecorder rec(single_file, logger, telemetry::TelemetryRecorder::OpenMode::Truncate);
+            for (const auto& p : payloads) {
+                rec.write_packet(p);
+            }
+        }
+        {
+            std::vector<std::span<const std::uint8_t>> batch(payloads.begin(), payloads.end());
+            telemetry::TelemetryRecorder rec(batch_file, logger, telemetry::TelemetryRecorder::OpenMode::Truncate);
+            rec.write_packets(batch);
+        }
+
+        if (read_file_bytes(single_file) != read_file_bytes(batch_file)) {
+            fail(tr, name, "batched file differs from per-packet file");
+            return;
+        }
+
+        auto r = telemetry::TelemetryReader::open(batch_file, logger);
+        std::vector<std::uint8_t> pkt;
+        for (const auto& p : payloads) {
+            if (!r.read_next(pkt) || pkt != p) {
+                fail(tr, name, "replayed packet mismatch");
+                return;
+            }
+        }
+        if (r.read_next(pkt)) {
+            fail(tr, name, "expected EOF after batch");
+            return;
+        }
+
+        pass(tr, name);
+    } catch (const std::exception& e) {
+        fail(tr, name, e.what());
+    }
+}
+
+static void test_async_recorder_matches_sync(TestResult& tr, const fs::path& dir,
+                                             telemetry::Logger& logger) {
+    const std::string name = "async_recorder_matches_sync_bytes";
+    const fs::path sync_file = dir / "sync_recorder.bin";
+    const fs::path async_file = dir / "async_recorder.bin";
+
+    std::vector<std::vector<std::uint8_t>> payloads;
+    for (std::size_t i = 0; i < 500; i++) {
+        payloads.emplace_back(1 + (i % 97), static_cast<std::uint8_t>(i));
+    }
+
+    try {
+        {
+            telemetry::TelemetryRecorder rec(sync_file, logger, telemetry::TelemetryRecorder::OpenMode::Truncate);
+            for (const auto& p : payloads) {
+                rec.write_packet(p);
+            }
+        }
+
+        telemetry::TelemetryRecorder::Options opt;
+        opt.async = true;
+        opt.async_buffer_bytes = 512; // tiny buffers force swaps and producer stalls
+        opt.backpressure = telemetry::TelemetryRecorder::Backpressure::Block;
+        {
+            telemetry::TelemetryRecorder rec(async_file, logger, telemetry::TelemetryRecorder::OpenMode::Truncate, opt);
+            for (std::size_t i = 0; i < payloads.size(); i++) {
+                rec.write_packet(payloads[i]);
+                if (i == payloads.size() / 2) {
+                    rec.flush();
+                    if (rec.stats().queued_bytes != 0) {
+                        fail(tr, name, "flush returned with records still queued");
+                        return;
+                    }
+                }
+            }
+            // Remaining records are drained by the destructor
+            if (rec.stats().dropped_packets != 0) {
+                fail(tr, name, "blocking policy dropped packets");
+                return;
+            }
+        }
+
+        if (read_file_bytes(sync_file) != read_file_bytes(async_file)) {
+            fail(tr, name, "async recording differs from sync recording");
+            return;
+        }
+
+        pass(tr, name);
+    } catch (const std::exception& e) {
+        fail(tr, name, e.what());
+    }
+}
+
+static std::vector<std::uint8_t> numbered_payload(std::uint32_t n) {
+    return {static_cast<std::uint8_t>(n & 0xFF), static_cast<std::uint8_t>((n >> 8) & 0xFF),
+            static_cast<std::uint8_t>((n >> 16) & 0xFF), static_cast<std::uint8_t>((n >> 24) & 0xFF)};
+}
+
+static void test_index_seek(TestResult& tr, const fs::path& dir, telemetry::Logger& logger) {
+    const std::string name = "index_footer_seek_to_record_and_time";
+    const fs::path file = dir / "indexed.bin";
+
+    telemetry::TelemetryRecorder::Options opt;
+    opt.index_interval = 16;
+
+    try {
+        {
+            telemetry::TelemetryRecorder rec(file, logger, telemetry::TelemetryRecorder::OpenMode::Truncate, opt);
+            for (std::uint32_t i = 0; i < 1000; i++) {
+                rec.write_packet(numbered_payload(i), std::uint64_t{i} * 10);
+            }
+        }
+        {
+            // Appending continues the existing index
+            telemetry::TelemetryRecorder rec(file, logger, telemetry::TelemetryRecorder::OpenMode::Append);
+            for (std::uint32_t i = 1000; i < 1100; i++) {
+                rec.write_packet(numbered_payload(i), std::uint64_t{i} * 10);
+            }
+        }
+
+        auto r = telemetry::TelemetryReader::open(file, logger);
+        if (!r.has_index() || r.record_count() != 1100 || r.index_interval() != 16) {
+            fail(tr, name, "index footer not loaded");
+            return;
+        }
+
+        std::vector<std::uint8_t> pkt;
+        for (std::uint32_t n : {537u, 3u, 1050u, 0u, 1099u}) {
+            if (!r.seek_to_record(n) || !r.read_next(pkt) || pkt != numbered_payload(n)) {
+                fail(tr, name, "seek_to_record(" + std::to_string(n) + ") landed on the wrong record");
+                return;
+            }
+        }
+        if (r.seek_to_record(1100)) {
+            fail(tr, name, "seek past the last record should return false");
+            return;
+        }
+
+        std::uint64_t start = r.seek_to_time(5375);
+        if (start > 537 || 537 - start >= r.index_interval()) {
+            fail(tr, name, "seek_to_time landed too far from the target");
+            return;
+        }
+        std::uint32_t first_match = 0;
+        while (r.read_next(pkt)) {
+            std::uint32_t n = pkt[0] | (pkt[1] << 8) | (pkt[2] << 16) | (pkt[3] << 24);
+            if (std::uint64_t{n} * 10 >= 5375) {
+                first_match = n;
+                break;
+            }
+        }
+        if (first_match != 538) {
+            fail(tr, name, "scan after seek_to_time found record " + std::to_string(first_match));
+            return;
+        }
+
+        // A full replay must stop at the footer, in both readers
+        r.seek_to_record(0);
+        std::size_t count = 0;
+        while (r.read_next(pkt)) {
+            ++count;
+        }
+        auto mapped = telemetry::MappedTelemetryReader::open(file, logger);
+        std::span<const std::uint8_t> view;
+        std::size_t mapped_count = 0;
+        while (mapped.next(view)) {
+            ++mapped_count;
+        }
+        if (count != 1100 || mapped_count != 1100) {
+            fail(tr, name, "replay did not stop at the index footer");
+            return;
+        }
+
+        pass(tr, name);
+    } catch (const std::exception& e) {
+        fail(tr, name, e.what());
+    }
+}
+
+// Outcome of replaying a file: payloads read before the first error + the error text.
+struct ReplayOutcome {
+    std::vector<std::vector<std::uint8_t>> packets;
+    std::string error;
+
+    bool operator==(const ReplayOutcome&) const = default;
+};
+
+static void test_index_seek_tied_timestamps(TestResult& tr, const fs::path& dir, telemetry::Logger& logger) {
+    const std::string name = "seek_to_time_with_tied_timestamps";
+    const fs::path file = dir / "tied_timestamps.bin";
+
+    // Records 0-11 share 100 ms (only record 0 carries it), 12-19 share 200 ms,
+    // then +10 ms per record. Record 24 is stamped backwards (clamped to 240).
+    auto timestamp = [](std::uint32_t i) -> std::uint64_t {
+        return i < 12 ? 100 : i < 20 ? 200 : 200 + (i - 19) * 10 - (i >= 24 ? 10 : 0);
+    };
+    telemetry::TelemetryRecorder::Options opt;
+    opt.index_interval = 4;
+
+    try {
+        {
+            telemetry::TelemetryRecorder rec(file, logger, telemetry::TelemetryRecorder::OpenMode::Truncate, opt);
+            for (std::uint32_t i = 0; i < 40; i++) {
+                if (i == 0 || i >= 12) {
+                    rec.write_packet(numbered_payload(i), i == 24 ? 50 : timestamp(i));
+                } else {
+                    rec.write_packet(numbered_payload(i));
+                }
+            }
+        }
+
+        auto r = telemetry::TelemetryReader::open(file, logger);
+        std::vector<std::uint8_t> pkt;
+        for (std::uint64_t ms : {std::uint64_t{100}, std::uint64_t{200}, std::uint64_t{230}, std::uint64_t{245}}) {
+            std::uint32_t target = 0;
+            while (timestamp(target) < ms) {
+                target++;
+            }
+            std::uint64_t start = r.seek_to_time(ms);
+            if (start > target || target - start > r.index_interval()) {
+                fail(tr, name, "seek_to_time(" + std::to_string(ms) + ") started at record " +
+                                   std::to_string(start) + ", first match is " + std::to_string(target));
+                return;
+            }
+            if (!r.read_next(pkt) || pkt != numbered_payload(static_cast<std::uint32_t>(start))) {
+                fail(tr, name, "seek_to_time(" + std::to_string(ms) + ") returned the wrong record number");
+                return;
+            }
+        }
+
+        pass(tr, name);
+    } catch (const std::exception& e) {
+        fail(tr, name, e.what());
+    }
+}
+
+static void test_index_footer_rejects_corrupt_trailer(TestResult& tr, const fs::path& dir, telemetry::Logger& logger) {
+    const std::string name = "index_footer_rejects_corrupt_trailer";
+    const fs::path file = dir / "index_corrupt.bin";
+    const fs::path bad_file = dir / "index_corrupt_trailer.bin";
+
+    // 100 records, interval 16: 7 entries + trailer at the end of the file
+    constexpr std::uint32_t kRecords = 100;
+    constexpr std::size_t kFooter = 7 * telemetry::format::kIndexEntrySize + telemetry::format::kIndexTrailerSize;
+    telemetry::TelemetryRecorder::Options opt;
+    opt.index_interval = 16;
+
+    auto put_u64 = [](std::vector<std::uint8_t>& bytes, std::size_t at, std::uint64_t v) {
+        for (int i = 0; i < 8; i++) {
+            bytes[at + i] = static_cast<std::uint8_t>(v >> (8 * i));
+        }
+    };
+    // Recomputes the footer CRC (entries + record_count/entry_count/interval)
+    auto reseal = [](std::vector<std::uint8_t>& bytes) {
+        const std::size_t start = bytes.size() - kFooter;
+        std::uint32_t crc = telemetry::crc32(std::span<const std::uint8_t>(bytes).subspan(start, kFooter - 8));
+        for (int i = 0; i < 4; i++) {
+            bytes[bytes.size() - 8 + i] = static_cast<std::uint8_t>(crc >> (8 * i));
+        }
+    };
+
+    try {
+        {
+            telemetry::TelemetryRecorder rec(file, logger, telemetry::TelemetryRecorder::OpenMode::Truncate, opt);
+            for (std::uint32_t i = 0; i < kRecords; i++) {
+                rec.write_packet(numbered_payload(i), std::uint64_t{i} * 10);
+            }
+        }
+        const auto good = read_file_bytes(file);
+        const std::size_t trailer = good.size() - telemetry::format::kIndexTrailerSize;
+        const std::size_t last_entry = good.size() - kFooter + 6 * telemetry::format::kIndexEntrySize;
+
+        struct Corruption {
+            const char* what;
+            bool resealed;
+            std::function<void(std::vector<std::uint8_t>&)> apply;
+        };
+        const std::vector<Corruption> cases = {
+            {"record_count without CRC update", false,
+             [&](auto& b) { put_u64(b, trailer, 1'000'000); }},
+            {"record_count with CRC update", true,
+             [&](auto& b) { put_u64(b, trailer, 1'000'000); }},
+            {"entry offset past the footer", true,
+             [&](auto& b) { put_u64(b, last_entry, b.size()); }},
+            {"entry offset inside the header", true,
+             [&](auto& b) { put_u64(b, last_entry, 2); }},
+        };
+
+        for (const auto& c : cases) {
+            auto bytes = good;
+            c.apply(bytes);
+            if (c.resealed) {
+                reseal(bytes);
+            }
+            {
+                std::ofstream out(bad_file, std::ios::binary | std::ios::trunc);
+                out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            }
+
+            auto r = telemetry::TelemetryReader::open(bad_file, logger);
+            if (r.has_index()) {
+                fail(tr, name, std::string("index accepted with ") + c.what);
+                return;
+            }
+
+            // Unindexed fallback: seeks walk the records (the footer reads as garbage)
+            std::vector<std::uint8_t> pkt;
+            if (!r.seek_to_record(42) || !r.read_next(pkt) || pkt != numbered_payload(42)) {
+                fail(tr, name, std::string("unindexed seek failed with ") + c.what);
+                return;
+            }
+            try {
+                if (r.seek_to_record(500'000)) {
+                    fail(tr, name, std::string("seek past the end succeeded with ") + c.what);
+                    return;
+                }
+            } catch (const telemetry::ParseError&) {
+            }
+        }
+        fs::remove(bad_file);
+
+        pass(tr, name);
+    } catch (const std::exception& e) {
+        fail(tr, name, e.what());
+    }
+}
+
+static void test_mapped_reader_matches_stream_reader(TestResult& tr, const fs::path& dir,
+                                                     telemetry::Logger& logger) {
+    const std::string name = "mapped_reader_matches_stream_reader";
+
+    // Add a CRC-corrupted file to the artifacts produced by earlier tests
+    {
+        std::ofstream out(dir / "bad_crc.bin", std::ios::binary);
+        write_header(out, telemetry::format::kCurrentVersion, 0);
+        write_record(out, {0x01, 0x02});
+        write_u32_le(out, 3 + telemetry::format::CRC32_SIZE);
+        const std::array<std::uint8_t, 3> payload = {0x0A, 0x0B, 0x0C};
+        out.write(reinterpret_cast<const char*>(payload.data()), 3);
+        write_crc(out, 0xDEADBEEF);
+    }
+
+    int files = 0;
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        ReplayOutcome stream_outcome;
+        try {
+            auto r = telemetry::TelemetryReader::open(entry.path(), logger);
+            std::vector<std::uint8_t> pkt;
+            while (r.read_next(pkt)) {
+                stream_outcome.packets.push_back(pkt);
+            }
+        } catch (const telemetry::ParseError& e) {
+            stream_outcome.error = e.what();
+        }
+
+        ReplayOutcome mapped_outcome;
+        try {
+            auto r = telemetry::MappedTelemetryReader::open(entry.path(), logger);
+            std::span<const std::uint8_t> pkt;
+            while (r.next(pkt)) {
+                mapped_outcome.packets.emplace_back(pkt.begin(), pkt.end());
+            }
+        } catch (const telemetry::ParseError& e) {
+            mapped_outcome.error = e.what();
+        }
+
+        if (!(stream_outcome == mapped_outcome)) {
+            fail(tr, name, entry.path().filename().string() + ": stream error '" + stream_outcome.error +
+                           "' vs mapped error '" + mapped_outcome.error + "'");
+            return;
+        }
+        ++files;
+    }
+
+    if (files == 0) {
+        fail(tr, name, "no recordings to compare");
+        return;
+    }
+    pass(tr, name);
+}
+
+static void test_verify_matches_sequential_reader(TestResult& tr, const fs::path& dir,
+                                                  telemetry::Logger& logger) {
+    const std::string name = "verify_matches_sequential_reader";
+
+    telemetry::VerifyOptions opt;
+    opt.threads = 4;
+
+    // Same first error as read_next() for every artifact (clean, truncated, bad CRC, ...)
+    for (const auto& entry : fs::directory_iterator(dir)) {
+        ReplayOutcome stream_outcome;
+        try {
+            auto r = telemetry::TelemetryReader::open(entry.path(), logger);
+            std::vector<std::uint8_t> pkt;
+            while (r.read_next(pkt)) {
+                stream_outcome.packets.push_back(pkt);
+            }
+        } catch (const telemetry::ParseError& e) {
+            stream_outcome.error = e.what();
+        }
+
+        auto report = telemetry::verify_recording(entry.path(), opt, logger);
+        if (report.error != stream_outcome.error ||
+            (!report.ok() && report.error_record != stream_outcome.packets.size())) {
+            fail(tr, name, entry.path().filename().string() + ": read_next error '" + stream_outcome.error +
+                           "' vs verify error '" + report.error + "'");
+            return;
+        }
+    }
+
+    // Many chunks, several corrupt records: all counted, the first one reported
+    const fs::path file = dir / "verify_many.bin";
+    constexpr std::uint32_t kRecords = 20000;
+    constexpr std::size_t kPayload = 100;
+    constexpr std::size_t kRecordBytes = kPayload + 8;
+    {
+        telemetry::TelemetryRecorder rec(file, logger, telemetry::TelemetryRecorder::OpenMode::Truncate);
+        std::vector<std::uint8_t> payload(kPayload);
+        for (std::uint32_t i = 0; i < kRecords; i++) {
+            payload[0] = static_cast<std::uint8_t>(i);
+            rec.write_packet(payload);
+        }
+    }
+    const std::uint32_t corrupt[] = {19999, 5000, 12000};
+    {
+        std::fstream f(file, std::ios::in | std::ios::out | std::ios::binary);
+        for (std::uint32_t n : corrupt) {
+            f.seekp(static_cast<std::streamoff>(telemetry::format::kHeaderSize + n * kRecordBytes + 10));
+            f.put(static_cast<char>(0x5A));
+        }
+    }
+
+    auto report = telemetry::verify_recording(file, opt, logger);
+    const std::uint64_t first_bad_offset = telemetry::format::kHeaderSize + 5000 * kRecordBytes;
+    if (report.records != kRecords || report.bad_records != 3 || report.error != "incorrect CRC" ||
+        report.error_record != 5000 || report.error_offset != first_bad_offset ||
+        report.bytes != kRecords * kRecordBytes) {
+        fail(tr, name, "expected 3 bad records starting at record 5000, got " +
+                       std::to_string(report.bad_records) + " starting at " + std::to_string(report.error_record));
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_async_logger(TestResult& tr, const fs::path& dir) {
+    const std::string name = "async_logger_drains_in_order";
+    const fs::path block_log = dir / "async_block.log";
+    const fs::path drop_log = dir / "async_drop.log";
+
+    auto read_lines = [](const fs::path& path) {
+        std::vector<std::string> lines;
+        std::ifstream in(path);
+        for (std::string line; std::getline(in, line);) {
+            lines.push_back(line);
+        }
+        return lines;
+    };
+
+    // Block: four producers through a tiny ring, nothing lost, per-thread order kept.
+    // Producer 0 also flushes while the others log: each flush must leave its lines on disk.
+    constexpr int kThreads = 4;
+    constexpr int kPerThread = 2000;
+    std::atomic<bool> flush_lost_lines{false};
+    {
+        telemetry::Logger::Options opt;
+        opt.async = true;
+        opt.queue_capacity = 64;
+        opt.overflow = telemetry::Logger::OverflowPolicy::Block;
+        telemetry::Logger logger(block_log.string(), telemetry::LogLevel::Info, false, opt);
+
+        std::vector<std::thread> producers;
+        for (int t = 0; t < kThreads; t++) {
+            producers.emplace_back([&, t] {
+                for (int i = 0; i < kPerThread; i++) {
+                    logger.info("t" + std::to_string(t) + " " + std::to_string(i));
+                    if (t == 0 && i % 500 == 499) {
+                        logger.flush();
+                        auto on_disk = read_lines(block_log);
+                        auto mine = std::count_if(on_disk.begin(), on_disk.end(), [](const std::string& line) {
+                            return line.find(" t0 ") != std::string::npos;
+                        });
+                        if (mine < i + 1) {
+                            flush_lost_lines = true;
+                        }
+                    }
+                }
+            });
+        }
+        for (auto& p : producers) {
+            p.join();
+        }
+    } // destructor drains
+
+    if (flush_lost_lines) {
+        fail(tr, name, "flush() returned before the caller's lines reached the file");
+        return;
+    }
+
+    std::array<int, kThreads> next{};
+    auto lines = read_lines(block_log);
+    for (const auto& line : lines) {
+        auto at = line.rfind(" t");
+        int t = std::stoi(line.substr(at + 2));
+        int i = std::stoi(line.substr(line.find(' ', at + 2) + 1));
+        if (line.rfind("[INFO] ", 0) != 0 || i != next[t]++) {
+            fail(tr, name, "out of order or malformed line: " + line);
+            return;
+        }
+    }
+    if (lines.size() != kThreads * kPerThread) {
+        fail(tr, name, "expected " + std::to_string(kThreads * kPerThread) + " lines, got " +
+                       std::to_string(lines.size()));
+        return;
+    }
+
+    // Drop: every message is either written or counted
+    constexpr int kMessages = 20000;
+    std::uint64_t dropped = 0;
+    {
+        telemetry::Logger::Options opt;
+        opt.async = true;
+        opt.queue_capacity = 8;
+        opt.overflow = telemetry::Logger::OverflowPolicy::Drop;
+        telemetry::Logger logger(drop_log.string(), telemetry::LogLevel::Info, false, opt);
+        for (int i = 0; i < kMessages; i++) {
+            logger.info("m " + std::to_string(i));
+        }
+        logger.flush();
+        dropped = logger.dropped_messages();
+    }
+    std::size_t written = read_lines(drop_log).size() - (dropped != 0 ? 1 : 0); // minus the summary line
+    if (written + dropped != kMessages) {
+        fail(tr, name, "drop policy lost track of messages");
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_format_logging_filters_before_formatting(TestResult& tr, const fs::path& dir) {
+    const std::string name = "format_logging_respects_levels";
+    const fs::path log = dir / "format.log";
+
+    {
+        telemetry::Logger logger(log.string(), telemetry::LogLevel::Warn, false);
+        if (logger.enabled(telemetry::LogLevel::Info) || !logger.enabled(telemetry::LogLevel::Warn)) {
+            fail(tr, name, "enabled() disagrees with the minimum level");
+            return;
+        }
+        logger.info("filtered t={} pos=({}, {})", 1, 2.5, 3.5);
+        logger.warn("kept size={} crc=0x{:X}", 36, 0xBEEFu);
+        logger.error("plain string overload still works");
+    }
+
+    std::ifstream in(log);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    if (lines.size() != 2 || lines[0].rfind("[WARN] ", 0) != 0 ||
+        lines[0].find(" kept size=36 crc=0xBEEF") == std::string::npos ||
+        lines[1].find("plain string overload still works") == std::string::npos) {
+        fail(tr, name, "unexpected log contents");
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_packet_writer_encoding(TestResult& tr) {
+    const std::string name = "packet_writer_word_encode_and_add_many";
+
+    // Reference bytes for each width, in both byte orders
+    const std::vector<std::uint8_t> big = {
+        0x01,
+        0x02, 0x03,
+        0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+        0x3F, 0x80, 0x00, 0x00,                 // 1.0f
+        0x00, 0x02, 'h', 'i',
+    };
+    std::vector<std::uint8_t> little = {
+        0x01,
+        0x03, 0x02,
+        0x07, 0x06, 0x05, 0x04,
+        0x0F, 0x0E, 0x0D, 0x0C, 0x0B, 0x0A, 0x09, 0x08,
+        0x00, 0x00, 0x80, 0x3F,
+        0x02, 0x00, 'h', 'i',
+    };
+
+    for (auto endianness : {telemetry::PacketWriter::Endianness::Big, telemetry::PacketWriter::Endianness::Little}) {
+        telemetry::PacketWriter pw(endianness);
+        pw.add_u8(0x01).add_u16(0x0203).add_u32(0x04050607).add_u64(0x08090A0B0C0D0E0FULL)
+          .add_float(1.0f).add_string("hi");
+        const auto& expected = (endianness == telemetry::PacketWriter::Endianness::Big) ? big : little;
+        if (!std::equal(pw.bytes().begin(), pw.bytes().end(), expected.begin(), expected.end())) {
+            fail(tr, name, "scalar encoding mismatch");
+            return;
+        }
+
+        // add_many<T> == add_* per element, across buffer growth
+        std::vector<std::uint32_t> words(100);
+        std::vector<float> floats(100);
+        for (std::size_t i = 0; i < words.size(); i++) {
+            words[i] = static_cast<std::uint32_t>(i * 0x01010101u);
+            floats[i] = static_cast<float>(i) * 0.5f;
+        }
+        telemetry::PacketWriter bulk(endianness);
+        telemetry::PacketWriter single(endianness);
+        bulk.add_many(std::span<const std::uint32_t>(words)).add_many(std::span<const float>(floats));
+        for (auto w : words) {
+            single.add_u32(w);
+        }
+        for (auto f : floats) {
+            single.add_float(f);
+        }
+        if (bulk.size() != 800 || !std::equal(bulk.bytes().begin(), bulk.bytes().end(),
+                                              single.bytes().begin(), single.bytes().end())) {
+            fail(tr, name, "add_many differs from per-element encoding");
+            return;
+        }
+    }
+
+    pass(tr, name);
+}
+
+static void test_packet_writer_caller_storage(TestResult& tr) {
+    const std::string name = "packet_writer_caller_storage_and_overflow";
+
+    auto encode = [](telemetry::PacketWriter& pw) {
+        pw.add_u64(0x1122334455667788ULL).add_float(2.5f).add_u16(7).add_string("ok");
+    };
+    telemetry::PacketWriter owning;
+    encode(owning);
+    auto same_as_owning = [&](const telemetry::PacketWriter& pw) {
+        return std::equal(pw.bytes().begin(), pw.bytes().end(), owning.bytes().begin(), owning.bytes().end());
+    };
+
+    // Inline storage: identical bytes, no overflow
+    telemetry::FixedPacketWriter<32> fixed;
+    encode(fixed);
+    if (fixed.overflowed() || !same_as_owning(fixed)) {
+        fail(tr, name, "FixedPacketWriter bytes differ from owning writer");
+        return;
+    }
+
+    // Span storage too small: writes that do not fit are skipped, no throw
+    std::array<std::uint8_t, 10> small{};
+    telemetry::PacketWriter tight{std::span<std::uint8_t>(small)};
+    encode(tight);
+    if (!tight.overflowed() || tight.size() != 8) {
+        fail(tr, name, "overflow not reported on caller-owned span");
+        return;
+    }
+    tight.clear();
+    tight.add_u32(1);
+    if (tight.overflowed() || tight.size() != 4) {
+        fail(tr, name, "clear() should reset the overflow flag");
+        return;
+    }
+
+    // Arena: packets are laid out back to back; a stale writer cannot overwrite its successor
+    std::array<std::uint8_t, 48> block{};
+    telemetry::PacketArena arena{std::span<std::uint8_t>(block)};
+    telemetry::PacketWriter first(arena);
+    encode(first);
+    telemetry::PacketWriter second(arena);
+    encode(second);
+    first.add_u8(0xFF);
+    if (!same_as_owning(second) || first.bytes().data() + first.size() != second.bytes().data() ||
+        !first.overflowed() || arena.used() != 2 * owning.size()) {
+        fail(tr, name, "arena packets not laid out back to back");
+        return;
+    }
+    telemetry::PacketWriter third(arena);
+    encode(third);
+    if (!third.overflowed()) {
+        fail(tr, name, "arena exhaustion not reported");
+        return;
+    }
+    arena.reset();
+    if (arena.used() != 0 || arena.allocate(48).size() != 48 || !arena.allocate(1).empty()) {
+        fail(tr, name, "arena reset/allocate mismatch");
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_compile_time_endianness(TestResult& tr) {
+    const std::string name = "basic_packet_codecs_match_runtime_endianness";
+
+    auto encode = [](auto& pw) {
+        pw.add_u8(0x01).add_u16(0x0203).add_u32(0x04050607).add_u64(0x08090A0B0C0D0E0FULL)
+          .add_float(-1.5f).add_string("abc");
+    };
+    auto decode_matches = [](auto& pr) {
+        std::array<std::uint8_t, 2> len{};
+        std::array<std::uint8_t, 3> text{};
+        bool ok = pr.read_u8() == 0x01 && pr.read_u16() == 0x0203 && pr.read_u32() == 0x04050607 &&
+                  pr.read_u64() == 0x08090A0B0C0D0E0FULL && pr.read_float() == -1.5f;
+        pr.read_bytes(len);
+        pr.read_bytes(text);
+        return ok && pr.empty() && text == std::array<std::uint8_t, 3>{'a', 'b', 'c'};
+    };
+
+    // Big endian: compile-time codecs produce and accept the runtime codecs' bytes
+    telemetry::PacketWriter runtime_big(telemetry::PacketWriter::Endianness::Big);
+    telemetry::BigEndianPacketWriter static_big;
+    encode(runtime_big);
+    encode(static_big);
+    telemetry::BigEndianPacketReader big_reader(runtime_big.bytes());
+    if (!std::equal(static_big.bytes().begin(), static_big.bytes().end(),
+                    runtime_big.bytes().begin(), runtime_big.bytes().end()) ||
+        !decode_matches(big_reader)) {
+        fail(tr, name, "big-endian bytes differ from PacketWriter");
+        return;
+    }
+
+    // Little endian, through inline storage
+    telemetry::PacketWriter runtime_little(telemetry::PacketWriter::Endianness::Little);
+    telemetry::FixedPacketWriter<32, telemetry::LittleEndianPacketWriter> static_little;
+    encode(runtime_little);
+    encode(static_little);
+    telemetry::LittleEndianPacketReader little_reader(static_little.bytes());
+    telemetry::PacketReader runtime_reader(static_little.bytes(), telemetry::PacketReader::Endianness::Little);
+    if (static_little.overflowed() ||
+        !std::equal(static_little.bytes().begin(), static_little.bytes().end(),
+                    runtime_little.bytes().begin(), runtime_little.bytes().end()) ||
+        !decode_matches(little_reader) || !decode_matches(runtime_reader)) {
+        fail(tr, name, "little-endian bytes differ from PacketWriter");
+        return;
+    }
+
+    // A short read throws and consumes nothing
+    const std::array<std::uint8_t, 3> partial{1, 2, 3};
+    telemetry::BigEndianPacketReader short_reader{std::span<const std::uint8_t>(partial)};
+    try {
+        short_reader.read_u32();
+        fail(tr, name, "short read did not throw");
+        return;
+    } catch (const std::out_of_range&) {
+    }
+    if (short_reader.remaining() != 3 || short_reader.read_u16() != 0x0102) {
+        fail(tr, name, "short read consumed bytes");
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_packet_reader_bulk_and_try_reads(TestResult& tr) {
+    const std::string name = "packet_reader_read_struct_array_and_try_read";
+
+    telemetry::PacketWriter pw(telemetry::PacketWriter::Endianness::Little);
+    const std::vector<std::uint16_t> words = {1, 0x0203, 0xFFFF};
+    pw.add_u64(42).add_float(3.5f).add_u32(7).add_many(std::span<const std::uint16_t>(words));
+
+    telemetry::PacketReader pr(pw.bytes(), telemetry::PacketReader::Endianness::Little);
+    auto [ts, value, flags] = pr.read_struct<std::uint64_t, float, std::uint32_t>();
+    auto array = pr.read_array<std::uint16_t>(words.size());
+    if (ts != 42 || value != 3.5f || flags != 7 || array != words || !pr.empty()) {
+        fail(tr, name, "read_struct/read_array decode mismatch");
+        return;
+    }
+
+    // Non-throwing reads fail without consuming anything
+    telemetry::LittleEndianPacketReader lr(pw.bytes().first(10));
+    std::array<std::uint16_t, 6> six{};
+    if (lr.try_read_struct<std::uint64_t, float>() || lr.try_read_array(std::span<std::uint16_t>(six)) ||
+        lr.remaining() != 10 || lr.try_read<std::uint64_t>() != std::optional<std::uint64_t>(42) ||
+        lr.try_read<float>() || lr.remaining() != 2) {
+        fail(tr, name, "try_read consumed bytes or returned a value on a short buffer");
+        return;
+    }
+    try {
+        lr.read_array<std::uint32_t>(1);
+        fail(tr, name, "read_array past the end did not throw");
+        return;
+    } catch (const std::out_of_range&) {
+    }
+
+    // On a complete buffer the try_ variants decode like the throwing ones
+    telemetry::PacketReader again(pw.bytes(), telemetry::PacketReader::Endianness::Little);
+    auto fields = again.try_read_struct<std::uint64_t, float, std::uint32_t>();
+    if (!fields || *fields != std::tuple<std::uint64_t, float, std::uint32_t>(42, 3.5f, 7) ||
+        !again.try_read_array(std::span<std::uint16_t>(six).first(3)) || six[1] != 0x0203) {
+        fail(tr, name, "try_read_struct/try_read_array decode mismatch");
+        return;
+    }
+
+    pass(tr, name);
+}
+
+// Packet type described only by its schema (no hand-written codec)
+struct SchemaSample {
+    std::uint64_t ts = 0;
+    float value = 0.0f;
+    std::uint8_t channel = 0;
+    std::uint32_t flags = 0;
+
+    static constexpr auto schema() {
+        using telemetry::field;
+        return telemetry::make_schema(field("ts", &SchemaSample::ts),
+                                      field("value", &SchemaSample::value),
+                                      field("channel", &SchemaSample::channel),
+                                      field("flags", &SchemaSample::flags));
+    }
+};
+
+static void test_schema_codecs(TestResult& tr) {
+    const std::string name = "schema_generated_codecs";
+
+    static_assert(telemetry::wire_size_v<SchemaSample> == 17);
+    static_assert(telemetry::field_offsets_v<SchemaSample> == std::array<std::size_t, 4>{0, 8, 12, 13});
+    static_assert(std::is_same_v<telemetry::field_type_t<SchemaSample, 2>, std::uint8_t>);
+    static_assert(telemetry::field_name<SchemaSample, 3>() == "flags");
+
+    const std::vector<SchemaSample> rows = {{1000, 1.5f, 3, 0xAB}, {2000, -2.25f, 255, 7}};
+
+    // Generated encoder == hand-written field sequence
+    telemetry::PacketWriter generated;
+    telemetry::PacketWriter manual;
+    telemetry::encode(rows[0], generated);
+    manual.add_u64(1000).add_float(1.5f).add_u8(3).add_u32(0xAB);
+    if (!std::equal(generated.bytes().begin(), generated.bytes().end(),
+                    manual.bytes().begin(), manual.bytes().end())) {
+        fail(tr, name, "generated encoder differs from hand-written encoding");
+        return;
+    }
+
+    // Decode, non-throwing decode of a truncated packet, and projection
+    SchemaSample decoded;
+    telemetry::PacketReader pr(generated.bytes());
+    telemetry::decode(decoded, pr);
+    telemetry::PacketReader truncated(generated.bytes().first(16));
+    SchemaSample untouched;
+    auto projected = telemetry::decode_fields<SchemaSample, std::endian::big, 3, 0>(generated.bytes());
+    if (decoded.ts != 1000 || decoded.value != 1.5f || decoded.channel != 3 || decoded.flags != 0xAB ||
+        telemetry::try_decode(untouched, truncated) || untouched.ts != 0 ||
+        !projected || *projected != std::tuple<std::uint32_t, std::uint64_t>(0xAB, 1000) ||
+        telemetry::decode_fields<SchemaSample, std::endian::big, 0>(generated.bytes().first(16))) {
+        fail(tr, name, "schema decode/projection mismatch");
+        return;
+    }
+
+    // Columns and CSV
+    auto channels = telemetry::extract_column<2>(std::span<const SchemaSample>(rows));
+    std::ostringstream csv;
+    csv << telemetry::csv_header<SchemaSample>() << "\n";
+    for (const auto& row : rows) {
+        telemetry::write_csv_row(csv, row);
+    }
+    if (channels != std::vector<std::uint8_t>{3, 255} ||
+        csv.str() != "ts,value,channel,flags\n1000,1.5,3,171\n2000,-2.25,255,7\n") {
+        fail(tr, name, "column/CSV output mismatch: " + csv.str());
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_batch_frame_decoder(TestResult& tr) {
+    const std::string name = "simd_batch_frame_decoder_matches_deserialize";
+
+    // 37 frames: full SIMD steps plus a scalar tail; varied bit patterns in every field
+    const std::size_t count = 37;
+    std::vector<telemetry_sim::TelemetryFrame> frames(count);
+    std::vector<std::vector<std::uint8_t>> encoded;
+    std::vector<std::uint8_t> region;          // framed records: [size][payload][crc]
+    for (std::size_t i = 0; i < count; i++) {
+        auto& f = frames[i];
+        f.timestamp_ms = 0x0102030405060708ULL * (i + 1);
+        f.temperature_c = 20.0f + static_cast<float>(i) * 0.25f;
+        f.voltage_v = -static_cast<float>(i);
+        f.position_x = static_cast<float>(i) * 1e-3f;
+        f.position_y = 1e6f / static_cast<float>(i + 1);
+        f.velocity_mps = static_cast<float>(i % 5);
+        f.status_flags = 0xA0B0C0D0u ^ static_cast<std::uint32_t>(i);
+
+        telemetry::PacketWriter pw;
+        f.serialize(pw);
+        encoded.emplace_back(pw.bytes().begin(), pw.bytes().end());
+        region.insert(region.end(), 4, 0xEE);
+        region.insert(region.end(), pw.bytes().begin(), pw.bytes().end());
+        region.insert(region.end(), 4, 0xEE);
+    }
+    std::vector<std::span<const std::uint8_t>> payloads(encoded.begin(), encoded.end());
+
+    for (auto engine : {telemetry_sim::FrameDecodeEngine::Scalar, telemetry_sim::FrameDecodeEngine::Sse,
+                        telemetry_sim::FrameDecodeEngine::Avx2}) {
+        for (int source = 0; source < 2; source++) {
+            std::vector<std::uint64_t> ts(count);
+            std::vector<float> temp(count), volt(count), px(count), py(count), vel(count);
+            std::vector<std::uint32_t> flags(count);
+            telemetry_sim::FrameColumns columns{ts, temp, volt, px, py, vel, flags};
+
+            std::size_t decoded = (source == 0)
+                ? telemetry_sim::decode_frames(payloads, columns, engine)
+                : telemetry_sim::decode_frames(std::span<const std::uint8_t>(region).subspan(4),
+                                               telemetry_sim::TelemetryFrame::kEncodedSize + 8, count, columns, engine);
+            if (decoded != count) {
+                fail(tr, name, std::string("short decode with engine ") + telemetry_sim::to_string(engine));
+                return;
+            }
+            for (std::size_t i = 0; i < count; i++) {
+                const auto& f = frames[i];
+                if (ts[i] != f.timestamp_ms || temp[i] != f.temperature_c || volt[i] != f.voltage_v ||
+                    px[i] != f.position_x || py[i] != f.position_y || vel[i] != f.velocity_mps ||
+                    flags[i] != f.status_flags) {
+                    fail(tr, name, std::string("column mismatch with engine ") + telemetry_sim::to_string(engine) +
+                                   " at frame " + std::to_string(i));
+                    return;
+                }
+            }
+        }
+    }
+
+    // A truncated payload ends the batch; undersized columns are rejected
+    payloads[20] = payloads[20].first(31);
+    std::vector<std::uint64_t> ts(count);
+    std::vector<float> f32(count);
+    std::vector<std::uint32_t> flags(count);
+    telemetry_sim::FrameColumns columns{ts, f32, f32, f32, f32, f32, flags};
+    bool threw = false;
+    try {
+        telemetry_sim::FrameColumns small = columns;
+        small.status_flags = small.status_flags.first(count - 1);
+        telemetry_sim::decode_frames(payloads, small);
+    } catch (const std::length_error&) {
+        threw = true;
+    }
+    if (telemetry_sim::decode_frames(payloads, columns) != 20 || !threw) {
+        fail(tr, name, "short payload / small columns not handled");
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_frame_batch(TestResult& tr) {
+    const std::string name = "telemetry_frame_batch_columns";
+
+    std::vector<telemetry_sim::TelemetryFrame> frames(100);
+    for (std::size_t i = 0; i < frames.size(); i++) {
+        frames[i].timestamp_ms = i * 100;
+        frames[i].temperature_c = static_cast<float>(i);
+        frames[i].velocity_mps = 0.5f * static_cast<float>(i);
+        frames[i].status_flags = static_cast<std::uint32_t>(i % 3);
+    }
+
+    // AoS -> columns -> AoS, with every column 64-byte aligned
+    telemetry_sim::TelemetryFrameBatch batch(std::span<const telemetry_sim::TelemetryFrame>(frames.data(), 60));
+    for (std::size_t i = 60; i < frames.size(); i++) {
+        batch.append(frames[i]);
+    }
+    auto aligned = [](const void* p) { return reinterpret_cast<std::uintptr_t>(p) % 64 == 0; };
+    auto back = batch.to_frames();
+    bool same = back.size() == frames.size();
+    for (std::size_t i = 0; same && i < frames.size(); i++) {
+        same = back[i].timestamp_ms == frames[i].timestamp_ms && back[i].temperature_c == frames[i].temperature_c &&
+               back[i].velocity_mps == frames[i].velocity_mps && back[i].status_flags == frames[i].status_flags;
+    }
+    if (!same || !aligned(batch.timestamp_ms().data()) || !aligned(batch.temperature_c().data()) ||
+        !aligned(batch.status_flags().data()) || batch.velocity_mps()[42] != 21.0f) {
+        fail(tr, name, "round trip or column alignment mismatch");
+        return;
+    }
+
+    // Chunked iteration covers every row exactly once
+    std::size_t rows = 0;
+    std::size_t chunks = 0;
+    std::uint64_t ts_sum = 0;
+    batch.for_each_chunk(32, [&](const telemetry_sim::FrameColumnsView& chunk) {
+        if (chunk.first != rows) {
+            rows = SIZE_MAX;
+        }
+        rows += chunk.size();
+        chunks++;
+        for (auto ts : chunk.timestamp_ms) {
+            ts_sum += ts;
+        }
+    });
+    if (rows != 100 || chunks != 4 || ts_sum != 100 * 99 / 2 * 100) {
+        fail(tr, name, "for_each_chunk did not cover the batch");
+        return;
+    }
+
+    // Encoded payloads decode straight into the columns
+    std::vector<std::uint8_t> packed;
+    for (const auto& f : frames) {
+        telemetry::PacketWriter pw;
+        f.serialize(pw);
+        packed.insert(packed.end(), pw.bytes().begin(), pw.bytes().end());
+    }
+    telemetry_sim::TelemetryFrameBatch decoded;
+    decoded.append(frames[0]);
+    if (decoded.append_encoded(packed, telemetry_sim::TelemetryFrame::kEncodedSize, frames.size()) != frames.size() ||
+        decoded.size() != 101 || decoded.frame(100).timestamp_ms != 9900 || decoded.frame(51).status_flags != 2) {
+        fail(tr, name, "append_encoded mismatch");
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_varint_encoding(TestResult& tr) {
+    const std::string name = "packet_varint_encoding";
+
+    telemetry::PacketWriter pw;
+    const std::array<std::uint64_t, 6> values{0, 1, 127, 128, 300, UINT64_MAX};
+    for (auto v : values) {
+        pw.add_varint(v);
+    }
+    pw.add_varint_signed(-1).add_varint_signed(63).add_varint_signed(-64).add_varint_signed(INT64_MIN);
+
+    // 1 + 1 + 1 + 2 + 2 + 10 bytes, then zigzag -1 / 63 / -64 in one byte each, INT64_MIN in 10
+    const std::vector<std::uint8_t> expected_prefix{0x00, 0x01, 0x7F, 0x80, 0x01, 0xAC, 0x02};
+    auto bytes = pw.bytes();
+    if (bytes.size() != 17 + 3 + 10 || !std::equal(expected_prefix.begin(), expected_prefix.end(), bytes.begin())) {
+        fail(tr, name, "unexpected LEB128 bytes");
+        return;
+    }
+
+    telemetry::PacketReader pr(bytes);
+    for (auto v : values) {
+        if (pr.read_varint() != v) {
+            fail(tr, name, "unsigned varint round trip mismatch");
+            return;
+        }
+    }
+    if (pr.read_varint_signed() != -1 || pr.read_varint_signed() != 63 || pr.read_varint_signed() != -64 ||
+        pr.read_varint_signed() != INT64_MIN || !pr.empty()) {
+        fail(tr, name, "signed varint round trip mismatch");
+        return;
+    }
+
+    // Truncated and over-long values fail without consuming anything
+    const std::vector<std::uint8_t> truncated{0x80, 0x80};
+    const std::vector<std::uint8_t> overlong(11, 0x80);
+    telemetry::PacketReader short_reader(truncated);
+    telemetry::PacketReader long_reader(overlong);
+    bool threw = false;
+    try {
+        long_reader.read_varint();
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    if (short_reader.try_read_varint() || short_reader.remaining() != 2 || !threw || long_reader.remaining() != 11) {
+        fail(tr, name, "malformed varint not rejected");
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_compact_frame_recording(TestResult& tr, const fs::path& dir, telemetry::Logger& logger) {
+    const std::string name = "compact_frame_recording_round_trip";
+    const fs::path compact_file = dir / "compact.bin";
+    const fs::path plain_file = dir / "plain.bin";
+
+    std::vector<telemetry_sim::TelemetryFrame> frames(300);
+    for (std::size_t i = 0; i < frames.size(); i++) {
+        frames[i].timestamp_ms = 1000 + i * 100 + (i % 7 == 0 ? 3 : 0);   // steady rate with jitter
+        frames[i].temperature_c = 20.0f + static_cast<float>(i % 11) * 0.25f;
+        frames[i].voltage_v = 12.0f - static_cast<float>(i) * 0.001f;
+        frames[i].position_x = static_cast<float>(i) * 0.01f;
+        frames[i].position_y = -static_cast<float>(i) * 0.01f;
+        frames[i].velocity_mps = 0.1f;
+        frames[i].status_flags = i < 150 ? 0 : 0x8000'0001u;
+    }
+
+    auto record = [&](const fs::path& file, std::uint16_t payload_flags, std::size_t first, std::size_t last,
+                      telemetry::TelemetryRecorder::OpenMode mode) {
+        telemetry::TelemetryRecorder::Options opt;
+        opt.index_interval = 32;
+        opt.payload_flags = payload_flags;
+        telemetry::TelemetryRecorder rec(file, logger, mode, opt);
+        telemetry_sim::CompactFrameEncoder encoder(rec.index_interval());
+        encoder.reset(rec.record_count());
+        telemetry::PacketWriter pw;
+        for (std::size_t i = first; i < last; i++) {
+            pw.clear();
+            if (payload_flags & telemetry::format::kFlagCompactFrames) {
+                encoder.encode(frames[i], pw);
+            } else {
+                frames[i].serialize(pw);
+            }
+            rec.write_packet(pw.bytes(), frames[i].timestamp_ms);
+        }
+    };
+
+    auto same_frame = [](const telemetry_sim::TelemetryFrame& a, const telemetry_sim::TelemetryFrame& b) {
+        return a.timestamp_ms == b.timestamp_ms && a.temperature_c == b.temperature_c && a.voltage_v == b.voltage_v &&
+               a.position_x == b.position_x && a.position_y == b.position_y && a.velocity_mps == b.velocity_mps &&
+               a.status_flags == b.status_flags;
+    };
+
+    try {
+        // Appending (at a record number that is not a key) continues the key schedule
+        record(compact_file, telemetry::format::kFlagCompactFrames, 0, 200, telemetry::TelemetryRecorder::OpenMode::Truncate);
+        record(compact_file, telemetry::format::kFlagCompactFrames, 200, 300, telemetry::TelemetryRecorder::OpenMode::Append);
+        record(plain_file, 0, 0, 300, telemetry::TelemetryRecorder::OpenMode::Truncate);
+
+        auto r = telemetry::TelemetryReader::open(compact_file, logger);
+        if (!(r.flags() & telemetry::format::kFlagCompactFrames) || r.record_count() != 300) {
+            fail(tr, name, "compact flag or index missing from the header");
+            return;
+        }
+
+        std::vector<std::uint8_t> pkt;
+        telemetry_sim::CompactFrameDecoder decoder;
+        telemetry_sim::TelemetryFrame frame;
+        for (std::size_t i = 0; i < frames.size(); i++) {
+            if (!r.read_next(pkt)) {
+                fail(tr, name, "recording ended early");
+                return;
+            }
+            telemetry::PacketReader pr(pkt);
+            decoder.decode(frame, pr);
+            if (!pr.empty() || !same_frame(frame, frames[i])) {
+                fail(tr, name, "frame " + std::to_string(i) + " did not round-trip");
+                return;
+            }
+        }
+
+        // Seeks land on key frames
+        std::uint64_t start = r.seek_to_time(frames[250].timestamp_ms);
+        decoder.reset();
+        r.read_next(pkt);
+        telemetry::PacketReader seek_reader(pkt);
+        decoder.decode(frame, seek_reader);
+        if (!same_frame(frame, frames[start])) {
+            fail(tr, name, "decode after seek_to_time mismatch");
+            return;
+        }
+
+        // A delta frame cannot be decoded without its key
+        r.seek_to_record(start + 1);
+        r.read_next(pkt);
+        telemetry::PacketReader delta_reader(pkt);
+        telemetry_sim::CompactFrameDecoder cold;
+        bool threw = false;
+        try {
+            cold.decode(frame, delta_reader);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) {
+            fail(tr, name, "delta frame decoded without a key frame");
+            return;
+        }
+
+        // Timestamps and flags shrink to ~2 bytes; the five floats are stored as-is
+        if (fs::file_size(compact_file) * 10 > fs::file_size(plain_file) * 8) {
+            fail(tr, name, "compact recording is not smaller: " + std::to_string(fs::file_size(compact_file)) +
+                               " vs " + std::to_string(fs::file_size(plain_file)) + " bytes");
+            return;
+        }
+
+        // Appending with a different payload encoding is refused
+        threw = false;
+        try {
+            record(compact_file, 0, 0, 1, telemetry::TelemetryRecorder::OpenMode::Append);
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        if (!threw) {
+            fail(tr, name, "append with mismatched payload flags accepted");
+            return;
+        }
+
+        // A drop would desync the encoder from the file: async Drop is refused up front,
+        // before the existing recording is truncated
+        const auto size_before = fs::file_size(compact_file);
+        threw = false;
+        try {
+            telemetry::TelemetryRecorder::Options opt;
+            opt.async = true;
+            opt.async_buffer_bytes = 64;   // a few frames: the next batch would be dropped
+            opt.backpressure = telemetry::TelemetryRecorder::Backpressure::Drop;
+            opt.index_interval = 32;
+            opt.payload_flags = telemetry::format::kFlagCompactFrames;
+            telemetry::TelemetryRecorder rec(compact_file, logger, telemetry::TelemetryRecorder::OpenMode::Truncate, opt);
+            telemetry_sim::CompactFrameEncoder encoder(rec.index_interval());
+            telemetry::PacketWriter pw;
+            for (const auto& f : frames) {
+                pw.clear();
+                encoder.encode(f, pw);
+                rec.write_packet(pw.bytes(), f.timestamp_ms);
+            }
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        if (!threw || fs::file_size(compact_file) != size_before) {
+            fail(tr, name, "compact frames accepted with Backpressure::Drop");
+            return;
+        }
+
+        pass(tr, name);
+    } catch (const std::exception& e) {
+        fail(tr, name, e.what());
+    }
+}
+
+static void test_bit_stream(TestResult& tr) {
+    const std::string name = "bit_writer_reader_round_trip";
+
+    telemetry::BitWriter bw;
+    bw.write_bits(0b101, 3);
+    bw.write_bit(true);
+    bw.write_bits(0xABCD, 16);
+    bw.write_bits(0x0123'4567'89AB'CDEFull, 64);   // crosses the accumulator boundary
+    bw.write_bits(0x7F, 7);
+    bw.write_bits(0, 0);
+
+    if (bw.bit_count() != 3 + 1 + 16 + 64 + 7) {
+        fail(tr, name, "bit_count mismatch");
+        return;
+    }
+    auto bytes = bw.finish();
+    if (bw.bit_count() != 3 + 1 + 16 + 64 + 7) {
+        fail(tr, name, "bit_count includes finish() padding");
+        return;
+    }
+    // 91 bits -> 12 bytes, MSB first: 1011 1010 1011 1100 1101 ...
+    if (bytes.size() != 12 || bytes[0] != 0xBA || bytes[1] != 0xBC || bytes[2] != 0xD0) {
+        fail(tr, name, "unexpected bit layout");
+        return;
+    }
+
+    telemetry::BitReader br(bytes);
+    if (br.read_bits(3) != 0b101 || !br.read_bit() || br.read_bits(16) != 0xABCD ||
+        br.read_bits(64) != 0x0123'4567'89AB'CDEFull || br.read_bits(7) != 0x7F) {
+        fail(tr, name, "read back mismatch");
+        return;
+    }
+
+    // Only the padding is left; reading past it throws without moving
+    const std::size_t pos = br.position();
+    bool threw = false;
+    try {
+        br.read_bits(8);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    if (!threw || br.position() != pos || br.remaining_bits() != 5 || br.read_bits(5) != 0) {
+        fail(tr, name, "end of stream not handled");
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_float_xor_codec(TestResult& tr) {
+    const std::string name = "float_xor_codec_lossless";
+
+    // A slowly drifting noisy signal, repeats, and special values
+    std::vector<float> values;
+    float level = 20.0f;
+    for (int i = 0; i < 2000; i++) {
+        level += 0.01f * static_cast<float>((i * 7919) % 13 - 6);
+        values.push_back(level);
+        if (i % 50 == 0) {
+            values.push_back(level);
+        }
+    }
+    values.insert(values.end(), {0.0f, -0.0f, std::numeric_limits<float>::infinity(),
+                                 std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::denorm_min(),
+                                 -std::numeric_limits<float>::max(), 1.0f});
+
+    telemetry::BitWriter bw;
+    telemetry::encode_float_column(values, bw);
+    auto bytes = bw.finish();
+
+    std::vector<float> decoded(values.size());
+    telemetry::BitReader br(bytes);
+    telemetry::decode_float_column(br, decoded);
+
+    for (std::size_t i = 0; i < values.size(); i++) {
+        if (std::bit_cast<std::uint32_t>(values[i]) != std::bit_cast<std::uint32_t>(decoded[i])) {
+            fail(tr, name, "value " + std::to_string(i) + " not bit-identical");
+            return;
+        }
+    }
+    if (bytes.size() >= values.size() * sizeof(float)) {
+        fail(tr, name, "no compression on a slowly changing series: " + std::to_string(bytes.size()) + " bytes");
+        return;
+    }
+
+    // A truncated stream throws instead of inventing values
+    telemetry::BitReader short_reader(bytes.first(bytes.size() / 2));
+    bool threw = false;
+    try {
+        telemetry::decode_float_column(short_reader, decoded);
+    } catch (const std::out_of_range&) {
+        threw = true;
+    }
+    if (!threw) {
+        fail(tr, name, "truncated stream decoded");
+        return;
+    }
+
+    // A value cut off mid-stream leaves the decoder and reader as they were: decoding
+    // resumes at the same bit in the full stream
+    for (std::size_t cut = 5; cut < bytes.size(); cut += 3) {
+        telemetry::FloatXorDecoder decoder;
+        telemetry::BitReader cut_reader(bytes.first(cut));
+        std::size_t next = 0;
+        try {
+            for (; next < values.size(); next++) {
+                decoder.decode(cut_reader);
+            }
+        } catch (const std::out_of_range&) {
+        }
+
+        telemetry::BitReader full(bytes);
+        for (std::size_t skip = cut_reader.position(); skip > 0;) {
+            const unsigned n = static_cast<unsigned>(std::min<std::size_t>(skip, 32));
+            full.read_bits(n);
+            skip -= n;
+        }
+        for (std::size_t i = next; i < std::min(next + 8, values.size()); i++) {
+            if (std::bit_cast<std::uint32_t>(decoder.decode(full)) != std::bit_cast<std::uint32_t>(values[i])) {
+                fail(tr, name, "decoder state changed by a truncated value (cut at byte " + std::to_string(cut) + ")");
+                return;
+            }
+        }
+    }
+
+    pass(tr, name);
+}
+
+static void test_lz_round_trip(TestResult& tr) {
+    const std::string name = "lz_compress_round_trip";
+
+    auto round_trip = [](std::span<const std::uint8_t> src, std::size_t& compressed) {
+        std::vector<std::uint8_t> packed(telemetry::lz_compress_bound(src.size()));
+        compressed = telemetry::lz_compress(src, packed);
+        std::vector<std::uint8_t> restored(src.size());
+        return compressed != 0 &&
+               telemetry::lz_decompress(std::span<const std::uint8_t>(packed).first(compressed), restored) &&
+               std::equal(restored.begin(), restored.end(), src.begin());
+    };
+
+    // Runs (overlapping matches), repeated records, pseudo-random bytes, tiny inputs
+    std::vector<std::uint8_t> runs(5000, 0xAA);
+    std::vector<std::uint8_t> records;
+    for (std::uint32_t i = 0; i < 2000; i++) {
+        const std::uint8_t record[] = {8, 0, 0, 0, static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i >> 8),
+                                       0x42, 0x42, 0xDE, 0xAD, 0xBE, 0xEF};
+        records.insert(records.end(), std::begin(record), std::end(record));
+    }
+    std::vector<std::uint8_t> noise(70000);
+    std::uint32_t state = 12345;
+    for (auto& b : noise) {
+        state = state * 1103515245u + 12345u;
+        b = static_cast<std::uint8_t>(state >> 24);
+    }
+
+    std::size_t runs_size = 0;
+    std::size_t records_size = 0;
+    std::size_t noise_size = 0;
+    std::size_t tiny_size = 0;
+    const std::vector<std::uint8_t> tiny{1, 2, 3};
+    if (!round_trip(runs, runs_size) || !round_trip(records, records_size) ||
+        !round_trip(noise, noise_size) || !round_trip(tiny, tiny_size) ||
+        !round_trip(std::span<const std::uint8_t>(), tiny_size)) {
+        fail(tr, name, "data did not round-trip");
+        return;
+    }
+    if (runs_size > 100 || records_size * 2 > records.size() ||
+        noise_size > telemetry::lz_compress_bound(noise.size())) {
+        fail(tr, name, "unexpected sizes: runs=" + std::to_string(runs_size) +
+                           " records=" + std::to_string(records_size) + " noise=" + std::to_string(noise_size));
+        return;
+    }
+
+    // Too small a destination fails instead of overrunning it
+    std::vector<std::uint8_t> small(records_size - 1);
+    if (telemetry::lz_compress(records, small) != 0) {
+        fail(tr, name, "compressed into a short buffer");
+        return;
+    }
+
+    // Malformed input is rejected, never decoded out of bounds
+    std::vector<std::uint8_t> packed(telemetry::lz_compress_bound(records.size()));
+    packed.resize(telemetry::lz_compress(records, packed));
+    std::vector<std::uint8_t> restored(records.size());
+    std::vector<std::uint8_t> bad_offset{0x04, 'a', 0xFF, 0x00};   // 4 bytes back from 1 byte of output
+    if (telemetry::lz_decompress(std::span<const std::uint8_t>(packed).first(packed.size() / 2), restored) ||
+        telemetry::lz_decompress(packed, std::span<std::uint8_t>(restored).first(restored.size() - 1)) ||
+        telemetry::lz_decompress(bad_offset, restored)) {
+        fail(tr, name, "malformed input accepted");
+        return;
+    }
+
+    pass(tr, name);
+}
+
+static void test_block_compressed_recording(TestResult& tr, const fs::path& dir, telemetry::Logger& logger) {
+    const std::string name = "block_compressed_recording_round_trip";
+    const fs::path file = dir / "blocks.bin";
+    constexpr std::uint32_t kRecords = 5000;
+
+    // Telemetry-like payloads: a counter, a slow timestamp and repeated status bytes
+    auto payload = [](std::uint32_t i) {
+        telemetry::PacketWriter pw;
+        pw.add_u32(i);
+        pw.add_u64(1'000'000 + std::uint64_t{i} * 10);
+        pw.add_u32(i / 100);
+        pw.add_u32(0x0000'00FF);
+        return std::vector<std::uint8_t>(pw.bytes().begin(), pw.bytes().end());
+    };
+
+    auto record = [&](std::uint32_t first, std::uint32_t last, telemetry::TelemetryRecorder::OpenMode mode,
+                      bool async) {
+        telemetry::TelemetryRecorder::Options opt;
+        opt.index_interval = 256;
+        opt.compress_blocks = true;
+        opt.block_bytes = 4096;
+        opt.async = async;
+        telemetry::TelemetryRecorder rec(file, logger, mode, opt);
+        for (std::uint32_t i = first; i < last; i++) {
+            rec.write_packet(payload(i), 1'000'000 + std::uint64_t{i} * 10);
+            if (i == first + 77) {
+                rec.flush();   // closes a short block mid-interval
+            }
+        }
+    };
+
+    try {
+        record(0, 3000, telemetry::TelemetryRecorder::OpenMode::Truncate, false);
+        record(3000, kRecords, telemetry::TelemetryRecorder::OpenMode::Append, true);
+
+        const std::uint64_t raw_bytes = telemetry::format::kHeaderSize +
+            std::uint64_t{kRecords} * (payload(0).size() + telemetry::format::kRecordSizeFieldBytes + telemetry::format::CRC32_SIZE);
+        if (fs::file_size(file) * 3 > raw_bytes * 2) {
+            fail(tr, name, "blocks not compressed: " + std::to_string(fs::file_size(file)) + " bytes");
+            return;
+        }
+
+        auto r = telemetry::TelemetryReader::open(file, logger);
+        if (!(r.flags() & telemetry::format::kFlagBlockCompressed) || r.record_count() != kRecords) {
+            fail(tr, name, "block flag or index missing from the header");
+            return;
+        }
+        std::vector<std::uint8_t> pkt;
+        for (std::uint32_t i = 0; i < kRecords; i++) {
+            if (!r.read_next(pkt) || pkt != payload(i)) {
+                fail(tr, name, "record " + std::to_string(i) + " did not round-trip");
+                return;
+            }
+        }
+        if (r.read_next(pkt)) {
+            fail(tr, name, "records after the end");
+            return;
+        }
+        r.seek_to_record(0);
+        auto batch = r.read_batch(kRecords + 1, 1 << 20);
+        const auto last = payload(kRecords - 1);
+        if (batch.size() != kRecords ||
+            !std::equal(batch.packet(kRecords - 1).begin(), batch.packet(kRecords - 1).end(), last.begin(), last.end())) {
+            fail(tr, name, "read_batch over blocks mismatch");
+            return;
+        }
+
+        // Index entries point at blocks; seeks skip inside the decompressed block
+        for (std::uint64_t n : {std::uint64_t{0}, std::uint64_t{1234}, std::uint64_t{3000}, std::uint64_t{4999}}) {
+            if (!r.seek_to_record(n) || !r.read_next(pkt) || pkt != payload(static_cast<std::uint32_t>(n))) {
+                fail(tr, name, "seek_to_record(" + std::to_string(n) + ") mismatch");
+                return;
+            }
+        }
+        std::uint64_t at = r.seek_to_time(1'000'000 + 4100 * 10);
+        if (at != 4096 || !r.read_next(pkt) || pkt != payload(4096) || r.seek_to_record(kRecords)) {
+            fail(tr, name, "seek_to_time / end seek mismatch");
+            return;
+        }
+
+        // Read-ahead stops at the index footer and restarts on seeks
+        telemetry::TelemetryReader::Options ahead;
+        ahead.read_ahead = true;
+        ahead.read_block_bytes = 4096;
+        auto ra = telemetry::TelemetryReader::open(file, ahead, logger);
+        for (std::uint32_t start : {1234u, 17u}) {
+            ra.seek_to_record(start);
+            for (std::uint32_t i = start; i < kRecords; i++) {
+                if (!ra.read_next(pkt) || pkt != payload(i)) {
+                    fail(tr, name, "read-ahead record " + std::to_string(i) + " mismatch");
+                    return;
+                }
+            }
+            if (ra.read_next(pkt)) {
+                fail(tr, name, "read-ahead read past the index footer");
+                return;
+            }
+        }
+
+        auto m = telemetry::MappedTelemetryReader::open(file, logger);
+        std::span<const std::uint8_t> view;
+        std::uint32_t mapped = 0;
+        while (m.next(view)) {
+            const auto expected = payload(mapped);
+            if (!std::equal(view.begin(), view.end(), expected.begin(), expected.end())) {
+                fail(tr, name, "mapped record " + std::to_string(mapped) + " mismatch");
+                return;
+            }
+            mapped++;
+        }
+
+        telemetry::VerifyOptions vopt;
+        vopt.threads = 3;
+        auto report = telemetry::verify_recording(file, vopt, logger);
+        if (mapped != kRecords || !report.ok() || report.records != kRecords) {
+            fail(tr, name, "mapped reader or verify disagree: " + std::to_string(mapped) + " / " +
+                               std::to_string(report.records) + " " + report.error);
+            return;
+        }
+
+        // Damage one byte inside the first block
+        auto bytes = read_file_bytes(file);
+        bytes[telemetry::format::kHeaderSize + telemetry::format::kBlockHeaderSize + 5] ^= 0x10;
+        {
+            std::ofstream out(file, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        auto damaged = telemetry::TelemetryReader::open(file, logger);
+        std::string error;
+        try {
+            damaged.read_next(pkt);
+        } catch (const telemetry::ParseError& e) {
+            error = e.what();
+        }
+        report = telemetry::verify_recording(file, vopt, logger);
+        if (error != "incorrect block CRC" || report.error != error || report.error_record != 0 ||
+            report.bad_blocks != 1 || report.records >= kRecords) {
+            fail(tr, name, "damaged block not reported: '" + error + "' / '" + report.error + "'");
+            return;
+        }
+
+        // A block whose CRC matches but whose LZ stream is invalid fails on every
+        // read, rather than handing out the half-decoded block on the retry
+        const fs::path lz_file = dir / "blocks_bad_lz.bin";
+        const std::size_t stored_at = telemetry::format::kHeaderSize + telemetry::format::kBlockHeaderSize;
+        const std::uint32_t stored_size = bytes[stored_at - 12] | (bytes[stored_at - 11] << 8) |
+                                          (bytes[stored_at - 10] << 16) | (bytes[stored_at - 9] << 24);
+        std::fill(bytes.begin() + stored_at, bytes.begin() + stored_at + stored_size, std::uint8_t{0xFF});
+        const std::uint32_t crc = telemetry::crc32(std::span<const std::uint8_t>(bytes).subspan(stored_at, stored_size));
+        for (int i = 0; i < 4; i++) {
+            bytes[stored_at - 4 + i] = static_cast<std::uint8_t>(crc >> (8 * i));
+        }
+        {
+            std::ofstream out(lz_file, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+
+        auto bad_lz = telemetry::TelemetryReader::open(lz_file, logger);
+        auto bad_lz_mapped = telemetry::MappedTelemetryReader::open(lz_file, logger);
+        for (int attempt = 0; attempt < 3; attempt++) {
+            std::string stream_error, batch_error, mapped_error;
+            try {
+                bad_lz.read_next(pkt);
+            } catch (const telemetry::ParseError& e) {
+                stream_error = e.what();
+            }
+            try {
+                bad_lz.read_batch(16, 1 << 20);
+            } catch (const telemetry::ParseError& e) {
+                batch_error = e.what();
+            }
+            try {
+                bad_lz_mapped.next(view);
+            } catch (const telemetry::ParseError& e) {
+                mapped_error = e.what();
+            }
+            if (stream_error != "corrupt compressed block" || batch_error != stream_error ||
+                mapped_error != stream_error) {
+                fail(tr, name, "read " + std::to_string(attempt) + " after a corrupt block: '" + stream_error +
+                                   "' / '" + batch_error + "' / '" + mapped_error + "'");
+                return;
+            }
+        }
+        fs::remove(lz_file);
+
+        pass(tr, name);
+    } catch (const std::exception& e) {
+        fail(tr, name, e.what());
+    }
+}
+
+static void test_buffered_reader_boundaries(TestResult& tr, const fs::path& dir, telemetry::Logger& logger) {
+    const std::string name = "buffered_reader_records_across_reads";
+    const fs::path file = dir / "boundaries.bin";
+    const fs::path cut_file = dir / "boundaries_cut.bin";
+
+    // Payloads of 0..89 bytes, so records straddle every position of a small read buffer
+    std::vector<std::vector<std::uint8_t>> payloads;
+    {
+        std::ofstream out(file, std::ios::binary);
+        write_header(out, telemetry::format::kCurrentVersion, 0);
+        for (std::size_t i = 0; i < 500; i++) {
+            std::vector<std::uint8_t> p((i * 37) % 90);
+            for (std::size_t k = 0; k < p.size(); k++) {
+                p[k] = static_cast<std::uint8_t>(i + k);
+            }
+            write_record(out, p);
+            payloads.push_back(std::move(p));
+        }
+    }
+
+    telemetry::TelemetryReader::Options small;
+    small.max_packet_size = 128;
+    small.read_block_bytes = 64;   // rounded up to one max-size record (136 bytes)
+
+    // Same checks through the read-ahead thread and queued io_uring reads
+    // (64-byte chunks, so most records span two)
+    for (int engine = 0; engine < 3; engine++) {
+        small.read_ahead = engine == 1;
+        small.io_uring = engine == 2;
+        const std::string mode = engine == 1 ? " (read-ahead)" : engine == 2 ? " (io_uring)" : "";
+
+        auto replay = [&](const fs::path& path) {
+            ReplayOutcome outcome;
+            try {
+                auto r = telemetry::TelemetryReader::open(path, small, logger);
+                std::span<const std::uint8_t> pkt;
+                while (r.read_next(pkt)) {
+                    outcome.packets.emplace_back(pkt.begin(), pkt.end());
+                }
+            } catch (const telemetry::ParseError& e) {
+                outcome.error = e.what();
+            }
+            return outcome;
+        };
+
+        ReplayOutcome full = replay(file);
+        if (!full.error.empty() || full.packets != payloads) {
+            fail(tr, name, "records lost or changed across read boundaries" + mode + ": " + full.error);
+            return;
+        }
+
+        // Rewinds (inside or outside the buffered window) and skips reuse the same framing
+        auto r = telemetry::TelemetryReader::open(file, small, logger);
+        std::vector<std::uint8_t> pkt;
+        for (std::uint64_t n : {std::uint64_t{7}, std::uint64_t{3}, std::uint64_t{400}, std::uint64_t{0}}) {
+            if (!r.seek_to_record(n) || !r.read_next(pkt) || pkt != payloads[n]) {
+                fail(tr, name, "seek_to_record(" + std::to_string(n) + ") mismatch" + mode);
+                return;
+            }
+        }
+
+        // Cutting the file anywhere inside the last records gives the errors the
+        // mapped reader (the in-memory framing rules) reports for the same bytes
+        const auto bytes = read_file_bytes(file);
+        for (std::size_t cut = bytes.size() - 300; cut < bytes.size(); cut++) {
+            {
+                std::ofstream out(cut_file, std::ios::binary | std::ios::trunc);
+                out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(cut));
+            }
+            ReplayOutcome buffered = replay(cut_file);
+            ReplayOutcome mapped;
+            try {
+                auto m = telemetry::MappedTelemetryReader::open(cut_file, logger);
+                std::span<const std::uint8_t> view;
+                while (m.next(view)) {
+                    mapped.packets.emplace_back(view.begin(), view.end());
+                }
+            } catch (const telemetry::ParseError& e) {
+                mapped.error = e.what();
+            }
+            if (!(buffered == mapped)) {
+                fail(tr, name, "cut at " + std::to_string(cut) + mode + ": '" + buffered.error + "' vs '" +
+                                   mapped.error + "'");
+                return;
+            }
+        }
+    }
+    fs::remove(cut_file);
+
+    pass(tr, name);
+}
+
+static void test_read_batch(TestResult& tr, const fs::path& dir, telemetry::Logger& logger) {
+    const std::string name = "read_batch_arena";
+    const fs::path file = dir / "batch.bin";
+    const fs::path bad_file = dir / "batch_bad_crc.bin";
+
+    std::vector<telemetry_sim::TelemetryFrame> frames(1000);
+    std::vector<std::uint64_t> offsets;
+    {
+        std::ofstream out(file, std::ios::binary);
+        write_header(out, telemetry::format::kCurrentVersion, 0);
+        std::uint64_t offset = telemetry::format::kHeaderSize;
+        for (std::size_t i = 0; i < frames.size(); i++) {
+            frames[i].timestamp_ms = 1000 + i;
+            frames[i].temperature_c = static_cast<float>(i) * 0.5f;
+            frames[i].status_flags = static_cast<std::uint32_t>(i);
+            telemetry::PacketWriter pw;
+            frames[i].serialize(pw);
+            write_record(out, std::vector<std::uint8_t>(pw.bytes().begin(), pw.bytes().end()));
+            offsets.push_back(offset);
+            offset += telemetry::format::kRecordSizeFieldBytes + pw.bytes().size() + telemetry::format::CRC32_SIZE;
+        }
+    }
+
+    try {
+        // Limits: 64 records or 40 frames' worth of bytes, whichever comes first
+        auto r = telemetry::TelemetryReader::open(file, logger);
+        const std::size_t kFrame = telemetry_sim::TelemetryFrame::kEncodedSize;
+        std::vector<telemetry::PacketBatch> batches;
+        std::size_t total = 0;
+        for (auto batch = r.read_batch(64, 40 * kFrame); !batch.empty(); batch = r.read_batch(64, 40 * kFrame)) {
+            if (batch.size() > 40 || batch.first_record() != total || batch.payload_bytes() != batch.size() * kFrame) {
+                fail(tr, name, "batch limits or numbering wrong at record " + std::to_string(total));
+                return;
+            }
+            total += batch.size();
+            batches.push_back(std::move(batch));
+        }
+        if (total != frames.size()) {
+            fail(tr, name, "read " + std::to_string(total) + " of " + std::to_string(frames.size()) + " records");
+            return;
+        }
+
+        // Each batch moves to a worker whole; the arena is a packed frame region
+        std::vector<std::uint32_t> flags(frames.size());
+        std::vector<std::uint64_t> file_offsets(frames.size());
+        std::thread worker([&, owned = std::move(batches)]() {
+            for (const auto& batch : owned) {
+                const std::size_t first = batch.first_record();
+                std::vector<std::uint64_t> ts(batch.size());
+                std::vector<float> temp(batch.size()), volt(batch.size()), px(batch.size()), py(batch.size()),
+                    vel(batch.size());
+                telemetry_sim::FrameColumns out{ts, temp, volt, px, py, vel,
+                                                std::span<std::uint32_t>(flags).subspan(first, batch.size())};
+                telemetry_sim::decode_frames(batch.arena(), kFrame, batch.size(), out);
+                for (std::size_t i = 0; i < batch.size(); i++) {
+                    file_offsets[first + i] = batch.file_offsets()[i];
+                }
+            }
+        });
+        worker.join();
+        for (std::size_t i = 0; i < frames.size(); i++) {
+            if (flags[i] != i || file_offsets[i] != offsets[i]) {
+                fail(tr, name, "record " + std::to_string(i) + " decoded wrong or has the wrong file offset");
+                return;
+            }
+        }
+
+        // A record larger than max_bytes still comes back, alone
+        r.seek_to_record(10);
+        auto single = r.read_batch(8, 1);
+        if (single.size() != 1 || single.first_record() != 10 ||
+            !std::equal(single.packet(0).begin(), single.packet(0).end(), single.arena().begin())) {
+            fail(tr, name, "oversized record not returned alone");
+            return;
+        }
+
+        // max_records == 0 is refused rather than passed off as EOF, and consumes nothing
+        bool threw = false;
+        try {
+            r.read_batch(0, 1 << 20);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        if (!threw || r.record_number() != 11) {
+            fail(tr, name, "read_batch with max_records == 0 not refused");
+            return;
+        }
+
+        // Records before a bad CRC are returned; the next call throws
+        auto bytes = read_file_bytes(file);
+        bytes[offsets[5] + telemetry::format::kRecordSizeFieldBytes] ^= 0x01;
+        {
+            std::ofstream out(bad_file, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        }
+        auto bad = telemetry::TelemetryReader::open(bad_file, logger);
+        auto before = bad.read_batch(64, 1 << 20);
+        std::string error;
+        try {
+            bad.read_batch(64, 1 << 20);
+        } catch (const telemetry::ParseError& e) {
+            error = e.what();
+        }
+        if (before.size() != 5 || error != "incorrect CRC") {
+            fail(tr, name, "bad CRC handling: " + std::to_string(before.size()) + " records, '" + error + "'");
+            return;
+        }
+
+        pass(tr, name);
+    } catch (const std::exception& e) {
+        fail(tr, name, e.what());
+    }
+}
+
+// ------------------------------
+// main()
+// ------------------------------
+static void test_write_backends(TestResult& tr, const fs::path& dir, telemetry::Logger& logger) {
+    const std::string name = "io_uring_and_direct_io_match_stream_recording";
+    const fs::path stream_file = dir / "backend_stream.bin";
+    const fs::path uring_file = dir / "backend_uring.bin";
+    const fs::path direct_file = dir / "backend_direct.bin";
+    using Recorder = telemetry::TelemetryRecorder;
+
+    std::vector<std::vector<std::uint8_t>> payloads;
+    for (std::uint32_t i = 0; i < 6000; i++) {
+        std::vector<std::uint8_t> p(1 + (i * 53) % 700);
+        for (std::size_t k = 0; k < p.size(); k++) {
+            p[k] = static_cast<std::uint8_t>(i * 7 + k);
+        }
+        payloads.push_back(std::move(p));
+    }
+
+    // Two sessions: a sync Truncate, then an Append (async on the second pass)
+    auto record = [&](const fs::path& path, Recorder::Options opt, bool async_append) {
+        opt.index_interval = 128;
+        const std::size_t half = payloads.size() / 2;
+        {
+            Recorder rec(path, logger, Recorder::OpenMode::Truncate, opt);
+            if (opt.io_uring && telemetry::IoUring::available() && !rec.using_io_uring()) {
+                throw std::runtime_error("io_uring available but not used");
+            }
+            for (std::size_t i = 0; i < half; i++) {
+                rec.write_packet(payloads[i], 1000 + i);
+                if (i == half / 2) {
+                    // Everything accepted so far is on disk after flush() (no O_DIRECT padding)
+                    rec.flush();
+                    if (!opt.compress_blocks &&
+                        fs::file_size(path) != rec.stats().bytes_written + telemetry::format::kHeaderSize) {
+                        throw std::runtime_error("flush left writes in flight");
+                    }
+                }
+            }
+        }
+        opt.async = async_append;
+        opt.async_buffer_bytes = 64 * 1024;
+        Recorder rec(path, logger, Recorder::OpenMode::Append, opt);
+        std::vector<std::span<const std::uint8_t>> batch;
+        std::vector<std::uint64_t> stamps;
+        for (std::size_t i = half; i < payloads.size(); i++) {
+            batch.emplace_back(payloads[i]);
+            stamps.push_back(1000 + i);
+        }
+        rec.write_packets(batch, stamps);
+    };
+
+    try {
+        for (bool blocks : {false, true}) {
+            for (bool async_append : {false, true}) {
+                const std::string mode = std::string(blocks ? " (blocks" : " (plain") +
+                                         (async_append ? ", async)" : ")");
+                Recorder::Options opt;
+                opt.compress_blocks = blocks;
+                opt.block_bytes = 8192;
+                record(stream_file, opt, async_append);
+
+                opt.io_uring = true;
+                opt.io_uring_buffer_bytes = 16 * 1024; // small buffers: many writes in flight
+                opt.io_uring_buffers = 3;
+                record(uring_file, opt, async_append);
+
+                // Each session ends mid-block, so Append rewrites a partial block
+                opt.io_uring = false;
+                opt.direct_io = true;
+                opt.direct_buffer_bytes = 5000; // rounded up to 8 KiB
+                record(direct_file, opt, async_append);
+
+                const auto expected = read_file_bytes(stream_file);
+                if (read_file_bytes(uring_file) != expected) {
+                    fail(tr, name, "io_uring recording differs from stream recording" + mode);
+                    return;
+                }
+                if (read_file_bytes(direct_file) != expected) {
+                    fail(tr, name, "O_DIRECT recording differs from stream recording" + mode);
+                    return;
+                }
+            }
+        }
+
+        // The io_uring reader replays and seeks like the stream reader
+        telemetry::TelemetryReader::Options ropt;
+        ropt.io_uring = true;
+        ropt.read_block_bytes = 8192;
+        auto r = telemetry::TelemetryReader::open(uring_file, ropt, logger);
+        std::vector<std::uint8_t> pkt;
+        for (std::uint64_t start : {std::uint64_t{0}, std::uint64_t{4321}, std::uint64_t{77}}) {
+            if (!r.seek_to_record(start)) {
+                fail(tr, name, "io_uring reader seek to " + std::to_string(start) + " failed");
+                return;
+            }
+            for (std::size_t i = start; i < payloads.size(); i++) {
+                if (!r.read_next(pkt) || pkt != payloads[i]) {
+                    fail(tr, name, "io_uring reader record " + std::to_string(i) + " mismatch");
+                    return;
+                }
+            }
+            if (r.read_next(pkt)) {
+                fail(tr, name, "io_uring reader read past the index footer");
+                return;
+            }
+        }
+
+        pass(tr, name);
+    } catch (const std::exception& e) {
+        fail(tr, name, e.what());
+    }
+}
+
 int main() {
     TestResult tr;
     telemetry::Logger logger("test.log", telemetry::LogLevel::Info, false);
@@ -357,6 +2375,33 @@ int main() {
     test_truncated_payload(tr, dir, logger);
     test_oversized_packet_rejected(tr, dir, logger);
     test_zero_size_packet_rejected(tr, dir, logger);
+    test_crc_engines_match_reference(tr);
+    test_crc_incremental_and_combine(tr);
+    test_batched_writes_match_single_writes(tr, dir, logger);
+    test_async_recorder_matches_sync(tr, dir, logger);
+    test_index_seek(tr, dir, logger);
+    test_index_seek_tied_timestamps(tr, dir, logger);
+    test_index_footer_rejects_corrupt_trailer(tr, dir, logger);
+    test_mapped_reader_matches_stream_reader(tr, dir, logger);
+    test_verify_matches_sequential_reader(tr, dir, logger);
+    test_async_logger(tr, dir);
+    test_format_logging_filters_before_formatting(tr, dir);
+    test_packet_writer_encoding(tr);
+    test_packet_writer_caller_storage(tr);
+    test_compile_time_endianness(tr);
+    test_packet_reader_bulk_and_try_reads(tr);
+    test_schema_codecs(tr);
+    test_batch_frame_decoder(tr);
+    test_frame_batch(tr);
+    test_varint_encoding(tr);
+    test_compact_frame_recording(tr, dir, logger);
+    test_bit_stream(tr);
+    test_float_xor_codec(tr);
+    test_lz_round_trip(tr);
+    test_block_compressed_recording(tr, dir, logger);
+    test_buffered_reader_boundaries(tr, dir, logger);
+    test_read_batch(tr, dir, logger);
+    test_write_backends(tr, dir, logger);
 
     std::cout << "\nSummary: " << tr.passed << " passed, " << tr.failed << " failed\n";
     return (tr.failed == 0) ? 0 : 1;
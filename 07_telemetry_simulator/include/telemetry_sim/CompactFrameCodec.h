@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "telemetry/PacketWriter.h"
+#include "telemetry/PacketReader.h"
+#include "telemetry/Varint.h"
+#include "TelemetryFrame.h"
+
+namespace telemetry_sim {
+
+    // Compact, lossless encoding for a stream of TelemetryFrames, used by recordings
+    // whose header carries telemetry::format::kFlagCompactFrames:
+    //
+    //   [u8 tag][timestamp varint][status_flags varint]?[5 x f32]
+    //
+    //   key frame  (tag bit 0): LEB128 timestamp, then LEB128 status_flags.
+    //   delta frame:            ZigZag LEB128 delta-of-delta of the timestamp
+    //                           (0 -> one byte at a steady rate); status_flags
+    //                           only if they changed (tag bit 1).
+    //
+    // The floats are written as-is in the writer's byte order. A delta frame depends
+    // on every frame back to the previous key, so keys are placed on the record
+    // numbers a recorder indexes (multiples of its index interval) and seeks land on them.
+    class CompactFrameEncoder {
+        public:
+            // Largest payload encode() writes (key frame with full-width varints)
+            static constexpr std::size_t kMaxEncodedSize =
+                1 + telemetry::kMaxVarintBytes + telemetry::varint_size(UINT32_MAX) + 5 * sizeof(float);
+
+            // key_interval > 0: a key frame on every record number that is a multiple
+            // of it; 0: only the first frame is a key.
+            explicit CompactFrameEncoder(std::uint32_t key_interval = 0) noexcept
+                : key_interval_(key_interval) {}
+
+            // Appends one frame to writer.
+            void encode(const TelemetryFrame& frame, telemetry::PacketWriter& writer);
+
+            // Starts a new stream whose next frame is record next_record (e.g. the
+            // recorder's record_count() when appending). The next frame is a key.
+            void reset(std::uint64_t next_record = 0) noexcept;
+
+            std::uint32_t key_interval() const noexcept { return key_interval_; }
+
+        private:
+            std::uint32_t key_interval_;
+            std::uint64_t record_ = 0;
+            bool have_key_ = false;
+            std::uint64_t prev_timestamp_ = 0;
+            std::int64_t prev_delta_ = 0;
+            std::uint32_t prev_flags_ = 0;
+    };
+
+    class CompactFrameDecoder {
+        public:
+            // Decodes the next payload of the stream into frame (frame and decoder
+            // are left unchanged on error). Throws std::out_of_range if the payload
+            // is truncated and std::runtime_error for an unknown tag or a delta frame
+            // without a preceding key (e.g. after seeking to a non-key record).
+            void decode(TelemetryFrame& frame, telemetry::PacketReader& reader);
+
+            // Forget the previous frames; call after seeking to a key record.
+            void reset() noexcept;
+
+        private:
+            bool have_key_ = false;
+            std::uint64_t prev_timestamp_ = 0;
+            std::int64_t prev_delta_ = 0;
+            std::uint32_t prev_flags_ = 0;
+    };
+
+} // namespace telemetry_sim
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "TelemetryFrame.h"
+
+namespace telemetry_sim {
+
+    // Batch decoder: many encoded TelemetryFrame payloads (big-endian, as written by
+    // TelemetryFrame::serialize) -> one column per field (structure of arrays).
+    //
+    // The SIMD engines load whole frames, byte-swap every 32-bit word in one shuffle
+    // and transpose 4 (SSE) or 8 (AVX2) frames at a time into the columns.
+    // Every engine produces bit-identical results.
+    enum class FrameDecodeEngine {
+        Scalar,   // one frame at a time (portable fallback)
+        Sse,      // SSSE3: 4 frames per step
+        Avx2      // AVX2: 8 frames per step
+    };
+
+    // Destination columns. Every span must hold at least as many values as
+    // there are payloads to decode.
+    struct FrameColumns {
+        std::span<std::uint64_t> timestamp_ms;
+        std::span<float> temperature_c;
+        std::span<float> voltage_v;
+        std::span<float> position_x;
+        std::span<float> position_y;
+        std::span<float> velocity_mps;
+        std::span<std::uint32_t> status_flags;
+
+        // Smallest column size (the most frames one call can decode)
+        std::size_t capacity() const noexcept;
+    };
+
+    // Decodes one payload per span (e.g. packets returned by a reader).
+    // Stops at the first payload shorter than TelemetryFrame::kEncodedSize and
+    // returns the number of frames decoded. Throws std::length_error if the
+    // columns are too small for every payload.
+    std::size_t decode_frames(std::span<const std::span<const std::uint8_t>> payloads,
+                              const FrameColumns& out);
+
+    // Decodes count payloads laid out every stride bytes, starting at region[0]
+    // (stride == kEncodedSize for packed payloads; kEncodedSize + 8 for the records
+    // of a recording, with region starting at the first payload). Returns the
+    // number decoded, which is less than count only if region is too short.
+    // Size fields and CRCs are not checked: validate the region first (e.g. verify).
+    std::size_t decode_frames(std::span<const std::uint8_t> region, std::size_t stride,
+                              std::size_t count, const FrameColumns& out);
+
+    // Same, with a specific engine (benchmarks / cross-checks). An engine the CPU
+    // does not support falls back to the next best supported one.
+    std::size_t decode_frames(std::span<const std::span<const std::uint8_t>> payloads,
+                              const FrameColumns& out, FrameDecodeEngine engine);
+    std::size_t decode_frames(std::span<const std::uint8_t> region, std::size_t stride,
+                              std::size_t count, const FrameColumns& out, FrameDecodeEngine engine);
+
+    // True if the engine can run on this CPU (runtime feature detection).
+    bool frame_decode_engine_supported(FrameDecodeEngine engine) noexcept;
+
+    // Engine used by decode_frames without an explicit engine.
+    FrameDecodeEngine frame_decode_active_engine() noexcept;
+
+    const char* to_string(FrameDecodeEngine engine) noexcept;
+
+} // namespace telemetry_sim
@@ -1,10 +1,12 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <array>
 #include <vector>
 #include "telemetry/PacketWriter.h"
 #include "telemetry/PacketReader.h"
+#include "telemetry/Schema.h"
 
 
 namespace telemetry_sim {
@@ -20,13 +22,36 @@ namespace telemetry_sim {
         float velocity_mps = 0.0f;      // meters per second
         uint32_t status_flags = 0;   // bitmask for error/status flags
 
-        // Serialize this frame into a PacketWriter payload.
-        // This function is small and explicit: each field is written in order.
+        // Wire layout, in order. serialize/deserialize, the encoded size, field
+        // offsets and CSV columns are all generated from this list.
+        static constexpr auto schema() {
+            using telemetry::field;
+            return telemetry::make_schema(field("timestamp_ms", &TelemetryFrame::timestamp_ms),
+                                          field("temperature_c", &TelemetryFrame::temperature_c),
+                                          field("voltage_v", &TelemetryFrame::voltage_v),
+                                          field("position_x", &TelemetryFrame::position_x),
+                                          field("position_y", &TelemetryFrame::position_y),
+                                          field("velocity_mps", &TelemetryFrame::velocity_mps),
+                                          field("status_flags", &TelemetryFrame::status_flags));
+        }
+
+        // Bytes written by serialize() (u64 + 5 x f32 + u32); checked against the schema below
+        static constexpr std::size_t kEncodedSize = 32;
+
+        // Serialize this frame into a PacketWriter payload (one capacity check).
         void serialize(telemetry::PacketWriter& writer) const;
 
-        // Desieralize the frame to assign struct members from a packet
+        // Desieralize the frame to assign struct members from a packet.
+        // Throws std::out_of_range if fewer than kEncodedSize bytes remain.
         void deserialize(telemetry::PacketReader& reader);
 
+        // Non-throwing variant for bulk replay: returns false (and leaves the
+        // frame and reader untouched) if the packet is too short.
+        bool try_deserialize(telemetry::PacketReader& reader) noexcept;
+
     };
 
+    static_assert(telemetry::wire_size_v<TelemetryFrame> == TelemetryFrame::kEncodedSize,
+                  "TelemetryFrame::kEncodedSize out of sync with its schema");
+
 } // namepsace telemetry_sim
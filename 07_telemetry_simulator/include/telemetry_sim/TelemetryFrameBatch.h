@@ -0,0 +1,100 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "telemetry/AlignedAllocator.h"
+#include "FrameDecoder.h"
+#include "TelemetryFrame.h"
+
+namespace telemetry_sim {
+
+    // Read-only view of rows [first, first + size()) of a TelemetryFrameBatch.
+    struct FrameColumnsView {
+        std::size_t first = 0;
+        std::span<const std::uint64_t> timestamp_ms;
+        std::span<const float> temperature_c;
+        std::span<const float> voltage_v;
+        std::span<const float> position_x;
+        std::span<const float> position_y;
+        std::span<const float> velocity_mps;
+        std::span<const std::uint32_t> status_flags;
+
+        std::size_t size() const noexcept { return timestamp_ms.size(); }
+    };
+
+    // Frames stored column by column (structure of arrays). Each field is one
+    // contiguous, 64-byte-aligned array, so a scan over one field touches only
+    // that field's bytes and vectorizes cleanly.
+    class TelemetryFrameBatch {
+        public:
+            static constexpr std::size_t kAlignment = 64;
+
+            template <class T>
+            using Column = std::vector<T, telemetry::AlignedAllocator<T, kAlignment>>;
+
+            TelemetryFrameBatch() = default;
+            explicit TelemetryFrameBatch(std::span<const TelemetryFrame> frames);
+
+            std::size_t size() const noexcept { return timestamp_ms_.size(); }
+            bool empty() const noexcept { return timestamp_ms_.empty(); }
+            std::size_t capacity() const noexcept { return timestamp_ms_.capacity(); }
+
+            void reserve(std::size_t frames);
+            void clear() noexcept;
+
+            void append(const TelemetryFrame& frame);
+            void append(std::span<const TelemetryFrame> frames);
+
+            // Decodes encoded payloads straight into the columns (see decode_frames)
+            // and returns how many were appended.
+            std::size_t append_encoded(std::span<const std::span<const std::uint8_t>> payloads);
+            std::size_t append_encoded(std::span<const std::uint8_t> region, std::size_t stride,
+                                       std::size_t count);
+
+            // Row i reassembled as a frame
+            TelemetryFrame frame(std::size_t i) const;
+
+            // Back to array-of-structs. copy_to throws std::length_error if out is too small.
+            void copy_to(std::span<TelemetryFrame> out) const;
+            std::vector<TelemetryFrame> to_frames() const;
+
+            std::span<const std::uint64_t> timestamp_ms() const noexcept { return timestamp_ms_; }
+            std::span<const float> temperature_c() const noexcept { return temperature_c_; }
+            std::span<const float> voltage_v() const noexcept { return voltage_v_; }
+            std::span<const float> position_x() const noexcept { return position_x_; }
+            std::span<const float> position_y() const noexcept { return position_y_; }
+            std::span<const float> velocity_mps() const noexcept { return velocity_mps_; }
+            std::span<const std::uint32_t> status_flags() const noexcept { return status_flags_; }
+
+            // Rows [first, first + count), clamped to size()
+            FrameColumnsView view(std::size_t first, std::size_t count) const noexcept;
+
+            // Calls fn(FrameColumnsView) for consecutive chunks of up to chunk_rows rows
+            // (e.g. sized to stay in L1/L2 while several columns are combined).
+            template <class Fn>
+            void for_each_chunk(std::size_t chunk_rows, Fn&& fn) const {
+                chunk_rows = std::max<std::size_t>(chunk_rows, 1);
+                for (std::size_t first = 0; first < size(); first += chunk_rows) {
+                    fn(view(first, chunk_rows));
+                }
+            }
+
+        private:
+            Column<std::uint64_t> timestamp_ms_;
+            Column<float> temperature_c_;
+            Column<float> voltage_v_;
+            Column<float> position_x_;
+            Column<float> position_y_;
+            Column<float> velocity_mps_;
+            Column<std::uint32_t> status_flags_;
+
+            // Grows every column to n rows and returns writable spans over [first, n)
+            FrameColumns grow_to(std::size_t n, std::size_t first);
+            void shrink_to(std::size_t n);
+    };
+
+} // namespace telemetry_sim
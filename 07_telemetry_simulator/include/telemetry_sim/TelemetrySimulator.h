@@ -5,6 +5,7 @@
 #include <vector>
 #include <span>
 #include "TelemetryFrame.h"
+#include "TelemetryFrameBatch.h"
 #include "telemetry/TelemetryRecorder.h"
 #include "telemetry/Logger.h"
 
@@ -31,7 +32,11 @@ namespace telemetry_sim {
             // Run the simulation: generates frames, serializes, and records them
             void run();
 
-            std::span<const TelemetryFrame> get_frames() const;
+            // Frames of the last run (only if saveFrames was set), one column per field
+            const TelemetryFrameBatch& get_batch() const;
+
+            // The same frames as array-of-structs (a copy)
+            std::vector<TelemetryFrame> get_frames() const;
 
         private:
             // Generate a single frame based on current simulator state
@@ -66,7 +71,7 @@ namespace telemetry_sim {
             std::normal_distribution<float> noise_velocity_;
             std::normal_distribution<float> noise_temperature_;
             std::normal_distribution<float> noise_voltage_;
-            std::vector<TelemetryFrame> frames_;
+            TelemetryFrameBatch frames_;
             bool save_frames_;
 
     };
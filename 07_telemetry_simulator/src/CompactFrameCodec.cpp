@@ -0,0 +1,101 @@
+#include <stdexcept>
+
+#include "telemetry_sim/CompactFrameCodec.h"
+
+namespace telemetry_sim {
+
+    namespace {
+
+        constexpr std::uint8_t kTagKey = 0x01;
+        constexpr std::uint8_t kTagFlagsChanged = 0x02;
+
+    }
+
+    void CompactFrameEncoder::encode(const TelemetryFrame& frame, telemetry::PacketWriter& writer) {
+        const bool key = !have_key_ || (key_interval_ > 0 && record_ % key_interval_ == 0);
+
+        if (key) {
+            writer.add_u8(kTagKey);
+            writer.add_varint(frame.timestamp_ms);
+            writer.add_varint(frame.status_flags);
+            prev_delta_ = 0;
+            have_key_ = true;
+        } else {
+            // Wrapping arithmetic: any timestamp sequence round-trips
+            const std::int64_t delta = static_cast<std::int64_t>(frame.timestamp_ms - prev_timestamp_);
+            const bool flags_changed = frame.status_flags != prev_flags_;
+            writer.add_u8(flags_changed ? kTagFlagsChanged : 0);
+            writer.add_varint_signed(static_cast<std::int64_t>(
+                static_cast<std::uint64_t>(delta) - static_cast<std::uint64_t>(prev_delta_)));
+            if (flags_changed) {
+                writer.add_varint(frame.status_flags);
+            }
+            prev_delta_ = delta;
+        }
+
+        writer.add_struct(frame.temperature_c, frame.voltage_v, frame.position_x,
+                          frame.position_y, frame.velocity_mps);
+
+        prev_timestamp_ = frame.timestamp_ms;
+        prev_flags_ = frame.status_flags;
+        record_++;
+    }
+
+    void CompactFrameEncoder::reset(std::uint64_t next_record) noexcept {
+        record_ = next_record;
+        have_key_ = false;
+        prev_timestamp_ = 0;
+        prev_delta_ = 0;
+        prev_flags_ = 0;
+    }
+
+    void CompactFrameDecoder::decode(TelemetryFrame& frame, telemetry::PacketReader& reader) {
+        const std::uint8_t tag = reader.read_u8();
+        if (tag & ~(kTagKey | kTagFlagsChanged)) {
+            throw std::runtime_error("compact frame: unknown tag bits");
+        }
+
+        std::uint64_t timestamp;
+        std::int64_t delta;
+        std::uint32_t flags = prev_flags_;
+
+        if (tag & kTagKey) {
+            timestamp = reader.read_varint();
+            flags = static_cast<std::uint32_t>(reader.read_varint());
+            delta = 0;
+        } else {
+            if (!have_key_) {
+                throw std::runtime_error("compact frame: delta frame without a preceding key frame");
+            }
+            const std::uint64_t dod = static_cast<std::uint64_t>(reader.read_varint_signed());
+            delta = static_cast<std::int64_t>(static_cast<std::uint64_t>(prev_delta_) + dod);
+            timestamp = prev_timestamp_ + static_cast<std::uint64_t>(delta);
+            if (tag & kTagFlagsChanged) {
+                flags = static_cast<std::uint32_t>(reader.read_varint());
+            }
+        }
+
+        auto [temperature, voltage, x, y, velocity] = reader.read_struct<float, float, float, float, float>();
+
+        frame.timestamp_ms = timestamp;
+        frame.temperature_c = temperature;
+        frame.voltage_v = voltage;
+        frame.position_x = x;
+        frame.position_y = y;
+        frame.velocity_mps = velocity;
+        frame.status_flags = flags;
+
+        have_key_ = true;
+        prev_timestamp_ = timestamp;
+        prev_delta_ = delta;
+        prev_flags_ = flags;
+    }
+
+    void CompactFrameDecoder::reset() noexcept {
+        have_key_ = false;
+        prev_timestamp_ = 0;
+        prev_delta_ = 0;
+        prev_flags_ = 0;
+    }
+
+} // namespace telemetry_sim
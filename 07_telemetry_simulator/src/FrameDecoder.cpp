@@ -0,0 +1,316 @@
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+#include "telemetry/ByteOrder.h"
+#include "telemetry/Schema.h"
+#include "telemetry_sim/FrameDecoder.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TELEMETRY_FRAME_DECODE_X86 1
+#endif
+
+namespace telemetry_sim {
+
+    namespace {
+
+        // The SIMD kernels see a frame as eight big-endian 32-bit words:
+        //   w0 w1 = timestamp_ms (high, low), w2..w6 = the floats, w7 = status_flags
+        static_assert(TelemetryFrame::kEncodedSize == 32);
+        static_assert(telemetry::field_offsets_v<TelemetryFrame> ==
+                      std::array<std::size_t, 7>{0, 8, 12, 16, 20, 24, 28},
+                      "FrameDecoder kernels assume the TelemetryFrame wire layout");
+
+        constexpr bool kSwap = (std::endian::native != std::endian::big);
+
+        // Payload i of a batch: consecutive spans, or fixed-stride records in one region
+        struct SpanSource {
+            const std::span<const std::uint8_t>* payloads;
+            const std::uint8_t* operator()(std::size_t i) const noexcept { return payloads[i].data(); }
+        };
+
+        struct StridedSource {
+            const std::uint8_t* base;
+            std::size_t stride;
+            const std::uint8_t* operator()(std::size_t i) const noexcept { return base + i * stride; }
+        };
+
+        template <class T>
+        inline T load_be(const std::uint8_t* p) noexcept {
+            telemetry::scalar_bits_t<T> bits;
+            std::memcpy(&bits, p, sizeof(bits));
+            return telemetry::bits_to_scalar<T>(bits, kSwap);
+        }
+
+        inline void decode_one(const std::uint8_t* p, const FrameColumns& out, std::size_t i) noexcept {
+            out.timestamp_ms[i] = load_be<std::uint64_t>(p);
+            out.temperature_c[i] = load_be<float>(p + 8);
+            out.voltage_v[i] = load_be<float>(p + 12);
+            out.position_x[i] = load_be<float>(p + 16);
+            out.position_y[i] = load_be<float>(p + 20);
+            out.velocity_mps[i] = load_be<float>(p + 24);
+            out.status_flags[i] = load_be<std::uint32_t>(p + 28);
+        }
+
+        template <class Source>
+        void decode_scalar(Source src, std::size_t first, std::size_t n, const FrameColumns& out) noexcept {
+            for (std::size_t i = first; i < n; i++) {
+                decode_one(src(i), out, i);
+            }
+        }
+
+#ifdef TELEMETRY_FRAME_DECODE_X86
+
+        template <class T>
+        __attribute__((target("ssse3")))
+        inline void store4(std::span<T> column, std::size_t i, __m128i v) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(column.data() + i), v);
+        }
+
+        // 4 frames per step: two 16-byte loads each, swap, 4x4 transposes
+        template <class Source>
+        __attribute__((target("ssse3")))
+        void decode_sse(Source src, std::size_t n, const FrameColumns& out) {
+            const __m128i bswap = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+            std::size_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m128i lo[4];
+                __m128i hi[4];
+#pragma GCC unroll 4
+                for (std::size_t k = 0; k < 4; k++) {
+                    const std::uint8_t* p = src(i + k);
+                    lo[k] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), bswap);
+                    hi[k] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 16)), bswap);
+                }
+
+                // Words 0-3 of each frame -> one register per word
+                __m128i t0 = _mm_unpacklo_epi32(lo[0], lo[1]);
+                __m128i t1 = _mm_unpackhi_epi32(lo[0], lo[1]);
+                __m128i t2 = _mm_unpacklo_epi32(lo[2], lo[3]);
+                __m128i t3 = _mm_unpackhi_epi32(lo[2], lo[3]);
+                __m128i w0 = _mm_unpacklo_epi64(t0, t2);
+                __m128i w1 = _mm_unpackhi_epi64(t0, t2);
+                __m128i w2 = _mm_unpacklo_epi64(t1, t3);
+                __m128i w3 = _mm_unpackhi_epi64(t1, t3);
+
+                // Words 4-7
+                t0 = _mm_unpacklo_epi32(hi[0], hi[1]);
+                t1 = _mm_unpackhi_epi32(hi[0], hi[1]);
+                t2 = _mm_unpacklo_epi32(hi[2], hi[3]);
+                t3 = _mm_unpackhi_epi32(hi[2], hi[3]);
+                __m128i w4 = _mm_unpacklo_epi64(t0, t2);
+                __m128i w5 = _mm_unpackhi_epi64(t0, t2);
+                __m128i w6 = _mm_unpacklo_epi64(t1, t3);
+                __m128i w7 = _mm_unpackhi_epi64(t1, t3);
+
+                // (low, high) word pairs -> little-endian u64 timestamps
+                store4(out.timestamp_ms, i, _mm_unpacklo_epi32(w1, w0));
+                store4(out.timestamp_ms, i + 2, _mm_unpackhi_epi32(w1, w0));
+                store4(out.temperature_c, i, w2);
+                store4(out.voltage_v, i, w3);
+                store4(out.position_x, i, w4);
+                store4(out.position_y, i, w5);
+                store4(out.velocity_mps, i, w6);
+                store4(out.status_flags, i, w7);
+            }
+            decode_scalar(src, i, n, out);
+        }
+
+        template <class T>
+        __attribute__((target("avx2")))
+        inline void store8(std::span<T> column, std::size_t i, __m256i v) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(column.data() + i), v);
+        }
+
+        // 8 frames per step: one 32-byte load each, swap, 8x8 transpose
+        template <class Source>
+        __attribute__((target("avx2")))
+        void decode_avx2(Source src, std::size_t n, const FrameColumns& out) {
+            const __m256i bswap = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                                   3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+            // The small loops below are fully unrolled so r/t/u/w live in registers
+            std::size_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                __m256i r[8];
+#pragma GCC unroll 8
+                for (std::size_t k = 0; k < 8; k++) {
+                    r[k] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src(i + k))), bswap);
+                }
+
+                // Within each 128-bit lane: 4x4 transposes of frames 0-3 and 4-7
+                __m256i t[8];
+#pragma GCC unroll 4
+                for (std::size_t k = 0; k < 8; k += 2) {
+                    t[k] = _mm256_unpacklo_epi32(r[k], r[k + 1]);
+                    t[k + 1] = _mm256_unpackhi_epi32(r[k], r[k + 1]);
+                }
+                __m256i u[8];
+#pragma GCC unroll 2
+                for (std::size_t k = 0; k < 8; k += 4) {
+                    u[k] = _mm256_unpacklo_epi64(t[k], t[k + 2]);
+                    u[k + 1] = _mm256_unpackhi_epi64(t[k], t[k + 2]);
+                    u[k + 2] = _mm256_unpacklo_epi64(t[k + 1], t[k + 3]);
+                    u[k + 3] = _mm256_unpackhi_epi64(t[k + 1], t[k + 3]);
+                }
+                // Low lanes hold words 0-3, high lanes words 4-7: stitch the two frame halves
+                __m256i w[8];
+#pragma GCC unroll 4
+                for (std::size_t k = 0; k < 4; k++) {
+                    w[k] = _mm256_permute2x128_si256(u[k], u[k + 4], 0x20);
+                    w[k + 4] = _mm256_permute2x128_si256(u[k], u[k + 4], 0x31);
+                }
+
+                // unpack works per lane: lo = frames 0,1 | 4,5 and hi = frames 2,3 | 6,7
+                __m256i ts_lo = _mm256_unpacklo_epi32(w[1], w[0]);
+                __m256i ts_hi = _mm256_unpackhi_epi32(w[1], w[0]);
+                store8(out.timestamp_ms, i, _mm256_permute2x128_si256(ts_lo, ts_hi, 0x20));
+                store8(out.timestamp_ms, i + 4, _mm256_permute2x128_si256(ts_lo, ts_hi, 0x31));
+                store8(out.temperature_c, i, w[2]);
+                store8(out.voltage_v, i, w[3]);
+                store8(out.position_x, i, w[4]);
+                store8(out.position_y, i, w[5]);
+                store8(out.velocity_mps, i, w[6]);
+                store8(out.status_flags, i, w[7]);
+            }
+            decode_scalar(src, i, n, out);
+        }
+
+        bool cpu_supports(FrameDecodeEngine engine) noexcept {
+            __builtin_cpu_init();
+            switch (engine) {
+                case FrameDecodeEngine::Scalar: return true;
+                case FrameDecodeEngine::Sse:    return __builtin_cpu_supports("ssse3");
+                case FrameDecodeEngine::Avx2:   return __builtin_cpu_supports("avx2");
+            }
+            return false;
+        }
+
+#else
+
+        template <class Source>
+        void decode_sse(Source src, std::size_t n, const FrameColumns& out) {
+            decode_scalar(src, 0, n, out);
+        }
+
+        template <class Source>
+        void decode_avx2(Source src, std::size_t n, const FrameColumns& out) {
+            decode_scalar(src, 0, n, out);
+        }
+
+        bool cpu_supports(FrameDecodeEngine engine) noexcept {
+            return engine == FrameDecodeEngine::Scalar;
+        }
+
+#endif
+
+        // The SIMD kernels assume a little-endian host (true on every x86)
+        bool engine_supported(FrameDecodeEngine engine) noexcept {
+            static const bool sse = std::endian::native == std::endian::little && cpu_supports(FrameDecodeEngine::Sse);
+            static const bool avx2 = std::endian::native == std::endian::little && cpu_supports(FrameDecodeEngine::Avx2);
+            switch (engine) {
+                case FrameDecodeEngine::Scalar: return true;
+                case FrameDecodeEngine::Sse:    return sse;
+                case FrameDecodeEngine::Avx2:   return avx2;
+            }
+            return false;
+        }
+
+        FrameDecodeEngine resolve(FrameDecodeEngine engine) noexcept {
+            if (engine == FrameDecodeEngine::Avx2 && !engine_supported(engine)) {
+                engine = FrameDecodeEngine::Sse;
+            }
+            if (engine == FrameDecodeEngine::Sse && !engine_supported(engine)) {
+                engine = FrameDecodeEngine::Scalar;
+            }
+            return engine;
+        }
+
+        template <class Source>
+        void run(FrameDecodeEngine engine, Source src, std::size_t n, const FrameColumns& out) {
+            switch (resolve(engine)) {
+                case FrameDecodeEngine::Avx2:
+                    decode_avx2(src, n, out);
+                    break;
+                case FrameDecodeEngine::Sse:
+                    decode_sse(src, n, out);
+                    break;
+                case FrameDecodeEngine::Scalar:
+                    decode_scalar(src, 0, n, out);
+                    break;
+            }
+        }
+
+        void check_capacity(const FrameColumns& out, std::size_t count) {
+            if (out.capacity() < count) {
+                throw std::length_error("FrameColumns too small for the batch");
+            }
+        }
+
+    }
+
+    std::size_t FrameColumns::capacity() const noexcept {
+        return std::min({timestamp_ms.size(), temperature_c.size(), voltage_v.size(), position_x.size(),
+                         position_y.size(), velocity_mps.size(), status_flags.size()});
+    }
+
+    std::size_t decode_frames(std::span<const std::span<const std::uint8_t>> payloads,
+                              const FrameColumns& out, FrameDecodeEngine engine) {
+        check_capacity(out, payloads.size());
+
+        std::size_t n = 0;
+        while (n < payloads.size() && payloads[n].size() >= TelemetryFrame::kEncodedSize) {
+            n++;
+        }
+        run(engine, SpanSource{payloads.data()}, n, out);
+        return n;
+    }
+
+    std::size_t decode_frames(std::span<const std::uint8_t> region, std::size_t stride,
+                              std::size_t count, const FrameColumns& out, FrameDecodeEngine engine) {
+        if (stride < TelemetryFrame::kEncodedSize) {
+            throw std::invalid_argument("stride smaller than an encoded TelemetryFrame");
+        }
+        check_capacity(out, count);
+
+        std::size_t available = 0;
+        if (region.size() >= TelemetryFrame::kEncodedSize) {
+            available = (region.size() - TelemetryFrame::kEncodedSize) / stride + 1;
+        }
+        std::size_t n = std::min(count, available);
+        run(engine, StridedSource{region.data(), stride}, n, out);
+        return n;
+    }
+
+    std::size_t decode_frames(std::span<const std::span<const std::uint8_t>> payloads,
+                              const FrameColumns& out) {
+        return decode_frames(payloads, out, frame_decode_active_engine());
+    }
+
+    std::size_t decode_frames(std::span<const std::uint8_t> region, std::size_t stride,
+                              std::size_t count, const FrameColumns& out) {
+        return decode_frames(region, stride, count, out, frame_decode_active_engine());
+    }
+
+    bool frame_decode_engine_supported(FrameDecodeEngine engine) noexcept {
+        return engine_supported(engine);
+    }
+
+    FrameDecodeEngine frame_decode_active_engine() noexcept {
+        return resolve(FrameDecodeEngine::Avx2);
+    }
+
+    const char* to_string(FrameDecodeEngine engine) noexcept {
+        switch (engine) {
+            case FrameDecodeEngine::Scalar: return "scalar";
+            case FrameDecodeEngine::Sse:    return "sse";
+            case FrameDecodeEngine::Avx2:   return "avx2";
+        }
+        return "unknown";
+    }
+
+} // namespace telemetry_sim
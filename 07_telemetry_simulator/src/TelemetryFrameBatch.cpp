@@ -0,0 +1,141 @@
+#include <stdexcept>
+
+#include "telemetry_sim/TelemetryFrameBatch.h"
+
+namespace telemetry_sim {
+
+    TelemetryFrameBatch::TelemetryFrameBatch(std::span<const TelemetryFrame> frames) {
+        append(frames);
+    }
+
+    void TelemetryFrameBatch::reserve(std::size_t frames) {
+        timestamp_ms_.reserve(frames);
+        temperature_c_.reserve(frames);
+        voltage_v_.reserve(frames);
+        position_x_.reserve(frames);
+        position_y_.reserve(frames);
+        velocity_mps_.reserve(frames);
+        status_flags_.reserve(frames);
+    }
+
+    void TelemetryFrameBatch::clear() noexcept {
+        shrink_to(0);
+    }
+
+    void TelemetryFrameBatch::append(const TelemetryFrame& frame) {
+        timestamp_ms_.push_back(frame.timestamp_ms);
+        temperature_c_.push_back(frame.temperature_c);
+        voltage_v_.push_back(frame.voltage_v);
+        position_x_.push_back(frame.position_x);
+        position_y_.push_back(frame.position_y);
+        velocity_mps_.push_back(frame.velocity_mps);
+        status_flags_.push_back(frame.status_flags);
+    }
+
+    void TelemetryFrameBatch::append(std::span<const TelemetryFrame> frames) {
+        const std::size_t first = size();
+        FrameColumns out = grow_to(first + frames.size(), first);
+        for (std::size_t i = 0; i < frames.size(); i++) {
+            const TelemetryFrame& f = frames[i];
+            out.timestamp_ms[i] = f.timestamp_ms;
+            out.temperature_c[i] = f.temperature_c;
+            out.voltage_v[i] = f.voltage_v;
+            out.position_x[i] = f.position_x;
+            out.position_y[i] = f.position_y;
+            out.velocity_mps[i] = f.velocity_mps;
+            out.status_flags[i] = f.status_flags;
+        }
+    }
+
+    std::size_t TelemetryFrameBatch::append_encoded(std::span<const std::span<const std::uint8_t>> payloads) {
+        const std::size_t first = size();
+        std::size_t decoded = decode_frames(payloads, grow_to(first + payloads.size(), first));
+        shrink_to(first + decoded);
+        return decoded;
+    }
+
+    std::size_t TelemetryFrameBatch::append_encoded(std::span<const std::uint8_t> region, std::size_t stride,
+                                                    std::size_t count) {
+        const std::size_t first = size();
+        std::size_t decoded = decode_frames(region, stride, count, grow_to(first + count, first));
+        shrink_to(first + decoded);
+        return decoded;
+    }
+
+    TelemetryFrame TelemetryFrameBatch::frame(std::size_t i) const {
+        TelemetryFrame f;
+        f.timestamp_ms = timestamp_ms_[i];
+        f.temperature_c = temperature_c_[i];
+        f.voltage_v = voltage_v_[i];
+        f.position_x = position_x_[i];
+        f.position_y = position_y_[i];
+        f.velocity_mps = velocity_mps_[i];
+        f.status_flags = status_flags_[i];
+        return f;
+    }
+
+    void TelemetryFrameBatch::copy_to(std::span<TelemetryFrame> out) const {
+        if (out.size() < size()) {
+            throw std::length_error("output span smaller than the batch");
+        }
+        for (std::size_t i = 0; i < size(); i++) {
+            out[i] = frame(i);
+        }
+    }
+
+    std::vector<TelemetryFrame> TelemetryFrameBatch::to_frames() const {
+        std::vector<TelemetryFrame> frames(size());
+        copy_to(frames);
+        return frames;
+    }
+
+    FrameColumnsView TelemetryFrameBatch::view(std::size_t first, std::size_t count) const noexcept {
+        first = std::min(first, size());
+        count = std::min(count, size() - first);
+        FrameColumnsView v;
+        v.first = first;
+        v.timestamp_ms = timestamp_ms().subspan(first, count);
+        v.temperature_c = temperature_c().subspan(first, count);
+        v.voltage_v = voltage_v().subspan(first, count);
+        v.position_x = position_x().subspan(first, count);
+        v.position_y = position_y().subspan(first, count);
+        v.velocity_mps = velocity_mps().subspan(first, count);
+        v.status_flags = status_flags().subspan(first, count);
+        return v;
+    }
+
+    FrameColumns TelemetryFrameBatch::grow_to(std::size_t n, std::size_t first) {
+        // Geometric growth, like push_back, so repeated appends stay amortized O(1)
+        if (n > capacity()) {
+            reserve(std::max(n, capacity() * 2));
+        }
+        timestamp_ms_.resize(n);
+        temperature_c_.resize(n);
+        voltage_v_.resize(n);
+        position_x_.resize(n);
+        position_y_.resize(n);
+        velocity_mps_.resize(n);
+        status_flags_.resize(n);
+
+        FrameColumns out;
+        out.timestamp_ms = std::span<std::uint64_t>(timestamp_ms_).subspan(first);
+        out.temperature_c = std::span<float>(temperature_c_).subspan(first);
+        out.voltage_v = std::span<float>(voltage_v_).subspan(first);
+        out.position_x = std::span<float>(position_x_).subspan(first);
+        out.position_y = std::span<float>(position_y_).subspan(first);
+        out.velocity_mps = std::span<float>(velocity_mps_).subspan(first);
+        out.status_flags = std::span<std::uint32_t>(status_flags_).subspan(first);
+        return out;
+    }
+
+    void TelemetryFrameBatch::shrink_to(std::size_t n) {
+        timestamp_ms_.resize(n);
+        temperature_c_.resize(n);
+        voltage_v_.resize(n);
+        position_x_.resize(n);
+        position_y_.resize(n);
+        velocity_mps_.resize(n);
+        status_flags_.resize(n);
+    }
+
+} // namespace telemetry_sim
@@ -1,5 +1,9 @@
+#include <stdexcept>
+
 #include "telemetry/PacketWriter.h"
 #include "telemetry/PacketReader.h"
+#include "telemetry/TelemetryFormat.h"
+#include "telemetry_sim/CompactFrameCodec.h"
 #include "telemetry_sim/TelemetrySimulator.h"
 
 namespace telemetry_sim {
@@ -58,8 +62,12 @@ namespace telemetry_sim {
             return frame;
         }
 
-        std::span<const TelemetryFrame> TelemetrySimulator::get_frames() const {
-            return std::span<const TelemetryFrame>(frames_);
+        const TelemetryFrameBatch& TelemetrySimulator::get_batch() const {
+            return frames_;
+        }
+
+        std::vector<TelemetryFrame> TelemetrySimulator::get_frames() const {
+            return frames_.to_frames();
         }
 
         void TelemetrySimulator::run() {
@@ -73,6 +81,9 @@ namespace telemetry_sim {
             );
 
             frames_.clear();  // ensure clean run
+            if (save_frames_ && config_.step_ms > 0 && config_.end_time_ms > current_time_ms_) {
+                frames_.reserve((config_.end_time_ms - current_time_ms_ + config_.step_ms - 1) / config_.step_ms);
+            }
 
             logger_.info("Initial state: "
                 "position=(" + std::to_string(position_x_) + ", "
@@ -83,46 +94,48 @@ namespace telemetry_sim {
             );
 
 
+            // The recorder's header flags pick the payload encoding. Compact frames
+            // put their key frames on the records the recorder indexes.
+            const bool compact = (recorder_.flags() & telemetry::format::kFlagCompactFrames) != 0;
+            CompactFrameEncoder encoder(recorder_.index_interval());
+            encoder.reset(recorder_.record_count());
+
+            telemetry::FixedPacketWriter<CompactFrameEncoder::kMaxEncodedSize> pw;
+
             while (current_time_ms_ < config_.end_time_ms) {
                 auto frame = generate_frame();
                 if (current_time_ms_ % 1000 == 0) {
-                    logger_.info(
-                        "t=" + std::to_string(current_time_ms_) +
-                        "ms | pos=(" + std::to_string(position_x_) + ", "
-                                    + std::to_string(position_y_) + ")"
-                        + " | vel=" + std::to_string(velocity_mps_)
-                        + " | temp=" + std::to_string(temperature_c_)
-                        + " | volt=" + std::to_string(voltage_v_)
-                    );
+                    logger_.info("t={}ms | pos=({}, {}) | vel={} | temp={} | volt={}",
+                                 current_time_ms_, position_x_, position_y_,
+                                 velocity_mps_, temperature_c_, voltage_v_);
                 }
 
                 if (voltage_v_ < 11.5f) {
-                    logger_.warn(
-                        "Low voltage threshold breached: "
-                        + std::to_string(voltage_v_) + " V"
-                    );
+                    logger_.warn("Low voltage threshold breached: {} V", voltage_v_);
                 }
 
                 if (std::abs(velocity_mps_) > 5.0f) {
-                    logger_.warn(
-                        "Velocity exceeds expected range: "
-                        + std::to_string(velocity_mps_) + " m/s"
-                    );
+                    logger_.warn("Velocity exceeds expected range: {} m/s", velocity_mps_);
                 }
 
                 if (save_frames_) {
-                    frames_.push_back(frame);
+                    frames_.append(frame);
                 }
 
-                telemetry::PacketWriter pw;
-                frame.serialize(pw);
-                recorder_.write_packet(pw.bytes());
-                logger_.info(
-                    "Packet written | size=" +
-                    std::to_string(pw.bytes().size()) +
-                    " bytes | timestamp=" +
-                    std::to_string(frame.timestamp_ms)
-                );
+                // Inline storage reused every frame: no heap allocation per packet
+                pw.clear();
+                if (compact) {
+                    encoder.encode(frame, pw);
+                } else {
+                    frame.serialize(pw);
+                }
+                if (pw.overflowed()) {
+                    logger_.error("TelemetryFrame does not fit its encode buffer");
+                    throw std::length_error("TelemetryFrame exceeds its maximum encoded size");
+                }
+                recorder_.write_packet(pw.bytes(), frame.timestamp_ms);
+                logger_.info("Packet written | size={} bytes | timestamp={}",
+                             pw.bytes().size(), frame.timestamp_ms);
 
 
                 advance_state();
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+    // Keeps a value (and the writes behind it) observable to the optimizer.
+    template <class T>
+    inline void do_not_optimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct Result {
+        std::string name;
+        std::uint64_t ops = 0;            // operations timed in total
+        std::size_t batch = 0;            // operations per timed sample
+        double ns_per_op = 0.0;           // mean
+        double p50_ns = 0.0;              // per-op latency percentiles over samples
+        double p99_ns = 0.0;
+        double mb_per_s = 0.0;            // 0 if the benchmark moves no bytes
+        double items_per_s = 0.0;         // e.g. frames/s; 0 if not applicable
+    };
+
+    struct Options {
+        double min_time_s = 0.25;         // minimum timed duration per benchmark
+        std::size_t min_samples = 100;    // enough samples for a meaningful p99
+        std::string filter;               // run only benchmarks whose name contains this
+    };
+
+    // Times one operation repeatedly and aggregates the results.
+    //
+    // The operation is called as op(n) and must perform n operations. Fast
+    // operations are grouped into batches long enough to time reliably (>= 20 us);
+    // p50/p99 are computed over the per-op time of each batch.
+    class Suite {
+        public:
+            explicit Suite(Options opt);
+
+            void run(const std::string& name,
+                     std::size_t bytes_per_op,
+                     std::size_t items_per_op,
+                     const std::function<void(std::size_t)>& op);
+
+            const std::vector<Result>& results() const noexcept { return results_; }
+
+            void print_table(std::ostream& out) const;
+            void write_json(std::ostream& out) const;
+
+        private:
+            Options opt_;
+            std::vector<Result> results_;
+    };
+
+} // namespace bench
@@ -0,0 +1,852 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "bench/Harness.h"
+#include "telemetry/BitStream.h"
+#include "telemetry/CRC.h"
+#include "telemetry/FloatXorCodec.h"
+#include "telemetry/Logger.h"
+#include "telemetry/Lz.h"
+#include "telemetry/MappedTelemetryReader.h"
+#include "telemetry/PacketReader.h"
+#include "telemetry/PacketWriter.h"
+#include "telemetry/Schema.h"
+#include "telemetry/TelemetryReader.h"
+#include "telemetry/TelemetryFormat.h"
+#include "telemetry/TelemetryRecorder.h"
+#include "telemetry_sim/CompactFrameCodec.h"
+#include "telemetry_sim/FrameDecoder.h"
+#include "telemetry_sim/TelemetryFrame.h"
+#include "telemetry_sim/TelemetryFrameBatch.h"
+#include "telemetry_sim/TelemetrySimulator.h"
+
+// Benchmark suite for the telemetry_lib hot paths.
+//
+// Usage: telemetry_bench [--json FILE] [--filter TEXT] [--min-time SECONDS] [--crc-engines] [--float-codec] [--block-codec] [--cold-replay]
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    const fs::path kWorkDir = "build/bench_tmp";
+
+    telemetry_sim::TelemetryFrame sample_frame() {
+        telemetry_sim::TelemetryFrame frame;
+        frame.timestamp_ms = 123456;
+        frame.temperature_c = 21.5f;
+        frame.voltage_v = 12.1f;
+        frame.position_x = 3.25f;
+        frame.position_y = -7.5f;
+        frame.velocity_mps = 1.75f;
+        frame.status_flags = 0x5;
+        return frame;
+    }
+
+    std::vector<std::uint8_t> encoded_frame() {
+        telemetry::PacketWriter pw;
+        sample_frame().serialize(pw);
+        return {pw.bytes().begin(), pw.bytes().end()};
+    }
+
+    void record_frames(const fs::path& path, telemetry::Logger& logger, std::size_t count) {
+        telemetry::TelemetryRecorder rec(path, logger, telemetry::TelemetryRecorder::OpenMode::Truncate);
+        auto frame = sample_frame();
+        telemetry::PacketWriter pw;
+        for (std::size_t i = 0; i < count; i++) {
+            frame.timestamp_ms = i * 10;
+            pw.clear();
+            frame.serialize(pw);
+            rec.write_packet(pw.bytes());
+        }
+    }
+
+    // ---- Serialization ----
+
+    void bench_codec(bench::Suite& suite) {
+        const auto frame = sample_frame();
+        const auto bytes = encoded_frame();
+
+        telemetry::PacketWriter pw;
+        pw.reserve(bytes.size());
+        suite.run("packet_writer_encode_frame", bytes.size(), 1, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                pw.clear();
+                frame.serialize(pw);
+                bench::do_not_optimize(pw.bytes().data());
+            }
+        });
+
+        telemetry::FixedPacketWriter<telemetry_sim::TelemetryFrame::kEncodedSize> fixed;
+        suite.run("fixed_writer_encode_frame", bytes.size(), 1, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                fixed.clear();
+                frame.serialize(fixed);
+                bench::do_not_optimize(fixed.bytes().data());
+            }
+        });
+
+        suite.run("packet_reader_decode_frame", bytes.size(), 1, [&](std::size_t n) {
+            telemetry_sim::TelemetryFrame out;
+            for (std::size_t i = 0; i < n; i++) {
+                telemetry::PacketReader pr(bytes);
+                out.deserialize(pr);
+                bench::do_not_optimize(out);
+            }
+        });
+
+        // Schema-generated decode through the compile-time big-endian reader
+        suite.run("basic_reader_decode_frame", bytes.size(), 1, [&](std::size_t n) {
+            telemetry_sim::TelemetryFrame out;
+            for (std::size_t i = 0; i < n; i++) {
+                telemetry::BigEndianPacketReader pr(bytes);
+                telemetry::decode(out, pr);
+                bench::do_not_optimize(out);
+            }
+        });
+    }
+
+    // Replay of a stream where one packet in 16 is truncated (corrupt)
+    void bench_corrupt_decode(bench::Suite& suite) {
+        const auto bytes = encoded_frame();
+        const std::span<const std::uint8_t> good(bytes);
+        const auto bad = good.first(bytes.size() / 2);
+
+        suite.run("packet_reader_try_decode_corrupt", bytes.size() * 16, 16, [&](std::size_t n) {
+            telemetry_sim::TelemetryFrame out;
+            for (std::size_t i = 0; i < n; i++) {
+                for (std::size_t k = 0; k < 16; k++) {
+                    telemetry::PacketReader pr(k == 15 ? bad : good);
+                    bench::do_not_optimize(out.try_deserialize(pr));
+                }
+            }
+        });
+
+        suite.run("packet_reader_throw_decode_corrupt", bytes.size() * 16, 16, [&](std::size_t n) {
+            telemetry_sim::TelemetryFrame out;
+            for (std::size_t i = 0; i < n; i++) {
+                for (std::size_t k = 0; k < 16; k++) {
+                    telemetry::PacketReader pr(k == 15 ? bad : good);
+                    try {
+                        out.deserialize(pr);
+                    } catch (const std::out_of_range&) {
+                    }
+                    bench::do_not_optimize(out);
+                }
+            }
+        });
+    }
+
+    // Batch decode of 4096 packed frames into columns: per-packet deserialize vs each engine
+    void bench_batch_decode(bench::Suite& suite) {
+        const std::size_t frames = 4096;
+        const auto one = encoded_frame();
+        std::vector<std::uint8_t> region;
+        region.reserve(frames * one.size());
+        for (std::size_t i = 0; i < frames; i++) {
+            region.insert(region.end(), one.begin(), one.end());
+        }
+
+        std::vector<std::uint64_t> ts(frames);
+        std::vector<float> temp(frames), volt(frames), px(frames), py(frames), vel(frames);
+        std::vector<std::uint32_t> flags(frames);
+        telemetry_sim::FrameColumns columns{ts, temp, volt, px, py, vel, flags};
+
+        suite.run("frame_decode_4096_deserialize", region.size(), frames, [&](std::size_t n) {
+            telemetry_sim::TelemetryFrame frame;
+            for (std::size_t i = 0; i < n; i++) {
+                for (std::size_t k = 0; k < frames; k++) {
+                    telemetry::PacketReader pr(std::span<const std::uint8_t>(region).subspan(k * one.size(), one.size()));
+                    frame.deserialize(pr);
+                    ts[k] = frame.timestamp_ms;
+                    temp[k] = frame.temperature_c;
+                    volt[k] = frame.voltage_v;
+                    px[k] = frame.position_x;
+                    py[k] = frame.position_y;
+                    vel[k] = frame.velocity_mps;
+                    flags[k] = frame.status_flags;
+                }
+                bench::do_not_optimize(ts.data());
+            }
+        });
+
+        for (auto engine : {telemetry_sim::FrameDecodeEngine::Scalar, telemetry_sim::FrameDecodeEngine::Sse,
+                            telemetry_sim::FrameDecodeEngine::Avx2}) {
+            if (!telemetry_sim::frame_decode_engine_supported(engine)) {
+                continue;
+            }
+            suite.run(std::string("frame_decode_4096_") + telemetry_sim::to_string(engine), region.size(), frames,
+                      [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    bench::do_not_optimize(telemetry_sim::decode_frames(region, one.size(), frames, columns, engine));
+                }
+            });
+        }
+    }
+
+    // Compact (delta/varint) encoding of a 4096-frame stream at a steady 100 ms rate.
+    // Bytes are the compact payload bytes, so the MB/s columns compare with frame_decode_*.
+    void bench_compact_codec(bench::Suite& suite) {
+        const std::size_t frames = 4096;
+        std::vector<telemetry_sim::TelemetryFrame> rows(frames, sample_frame());
+        for (std::size_t i = 0; i < frames; i++) {
+            rows[i].timestamp_ms += i * 100;
+        }
+
+        telemetry::PacketWriter pw;
+        std::vector<std::size_t> ends;
+        telemetry_sim::CompactFrameEncoder encoder(1024);
+        for (const auto& f : rows) {
+            encoder.encode(f, pw);
+            ends.push_back(pw.size());
+        }
+        const std::vector<std::uint8_t> stream(pw.bytes().begin(), pw.bytes().end());
+
+        suite.run("compact_frame_encode_4096", stream.size(), frames, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                pw.clear();
+                encoder.reset();
+                for (const auto& f : rows) {
+                    encoder.encode(f, pw);
+                }
+                bench::do_not_optimize(pw.bytes().data());
+            }
+        });
+
+        suite.run("compact_frame_decode_4096", stream.size(), frames, [&](std::size_t n) {
+            telemetry_sim::CompactFrameDecoder decoder;
+            telemetry_sim::TelemetryFrame frame;
+            for (std::size_t i = 0; i < n; i++) {
+                decoder.reset();
+                std::size_t begin = 0;
+                for (std::size_t end : ends) {
+                    telemetry::PacketReader pr(std::span<const std::uint8_t>(stream).subspan(begin, end - begin));
+                    decoder.decode(frame, pr);
+                    begin = end;
+                }
+                bench::do_not_optimize(frame.timestamp_ms);
+            }
+        });
+    }
+
+    // Frames above a temperature threshold (65536 frames): array-of-structs vs one batch column
+    void bench_column_scan(bench::Suite& suite) {
+        const std::size_t frames = 65536;
+        std::vector<telemetry_sim::TelemetryFrame> rows(frames, sample_frame());
+        for (std::size_t i = 0; i < frames; i++) {
+            rows[i].temperature_c = static_cast<float>(i % 100);
+        }
+        telemetry_sim::TelemetryFrameBatch batch(rows);
+
+        suite.run("scan_temperature_65536_aos", frames * sizeof(float), frames, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                std::uint32_t hot = 0;
+                for (const auto& f : rows) {
+                    hot += f.temperature_c > 50.0f;
+                }
+                bench::do_not_optimize(hot);
+            }
+        });
+
+        suite.run("scan_temperature_65536_batch", frames * sizeof(float), frames, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                std::uint32_t hot = 0;
+                for (float t : batch.temperature_c()) {
+                    hot += t > 50.0f;
+                }
+                bench::do_not_optimize(hot);
+            }
+        });
+    }
+
+    // ---- CRC ----
+
+    void bench_crc(bench::Suite& suite) {
+        std::mt19937 rng(42);
+        std::vector<std::uint8_t> buffer(1024 * 1024);
+        for (auto& b : buffer) {
+            b = static_cast<std::uint8_t>(rng());
+        }
+
+        for (std::size_t size : {std::size_t{36}, std::size_t{256}, std::size_t{4096},
+                                 std::size_t{65536}, std::size_t{1024 * 1024}}) {
+            std::span<const std::uint8_t> data(buffer.data(), size);
+            suite.run("crc32_" + std::to_string(size), size, 0, [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    bench::do_not_optimize(telemetry::crc32(data));
+                }
+            });
+        }
+    }
+
+    // ---- Recording / replay ----
+
+    void bench_recorder(bench::Suite& suite, telemetry::Logger& logger) {
+        const auto bytes = encoded_frame();
+        const std::size_t framed = bytes.size() + 8;
+
+        {
+            telemetry::TelemetryRecorder rec(kWorkDir / "write.bin", logger,
+                                             telemetry::TelemetryRecorder::OpenMode::Truncate);
+            suite.run("recorder_write_packet", framed, 1, [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    rec.write_packet(bytes);
+                }
+            });
+        }
+
+        {
+            telemetry::TelemetryRecorder rec(kWorkDir / "write.bin", logger,
+                                             telemetry::TelemetryRecorder::OpenMode::Truncate);
+            std::vector<std::span<const std::uint8_t>> batch(64, std::span<const std::uint8_t>(bytes));
+            suite.run("recorder_write_packets_x64", framed * batch.size(), batch.size(), [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    rec.write_packets(batch);
+                }
+            });
+        }
+
+        {
+            telemetry::TelemetryRecorder::Options opt;
+            opt.io_uring = true;
+            telemetry::TelemetryRecorder rec(kWorkDir / "write.bin", logger,
+                                             telemetry::TelemetryRecorder::OpenMode::Truncate, opt);
+            std::vector<std::span<const std::uint8_t>> batch(64, std::span<const std::uint8_t>(bytes));
+            suite.run("recorder_write_x64_io_uring", framed * batch.size(), batch.size(), [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    rec.write_packets(batch);
+                }
+            });
+        }
+
+        {
+            telemetry::TelemetryRecorder::Options opt;
+            opt.direct_io = true;
+            telemetry::TelemetryRecorder rec(kWorkDir / "write.bin", logger,
+                                             telemetry::TelemetryRecorder::OpenMode::Truncate, opt);
+            std::vector<std::span<const std::uint8_t>> batch(64, std::span<const std::uint8_t>(bytes));
+            suite.run("recorder_write_x64_direct_io", framed * batch.size(), batch.size(), [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    rec.write_packets(batch);
+                }
+            });
+        }
+        fs::remove(kWorkDir / "write.bin");
+    }
+
+    void bench_replay(bench::Suite& suite, telemetry::Logger& logger) {
+        const fs::path file = kWorkDir / "replay.bin";
+        const std::size_t packets = 100'000;
+        record_frames(file, logger, packets);
+        const std::size_t framed = encoded_frame().size() + 8;
+
+        {
+            auto reader = telemetry::TelemetryReader::open(file, logger);
+            std::vector<std::uint8_t> pkt;
+            suite.run("reader_read_next", framed, 1, [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    if (!reader.read_next(pkt)) {
+                        reader.seek_to_record(0);
+                        reader.read_next(pkt);
+                    }
+                    bench::do_not_optimize(pkt.data());
+                }
+            });
+        }
+
+        {
+            auto reader = telemetry::TelemetryReader::open(file, logger);
+            std::span<const std::uint8_t> pkt;
+            suite.run("reader_read_next_span", framed, 1, [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    if (!reader.read_next(pkt)) {
+                        reader.seek_to_record(0);
+                        reader.read_next(pkt);
+                    }
+                    bench::do_not_optimize(pkt.data());
+                }
+            });
+        }
+
+        {
+            telemetry::TelemetryReader::Options ahead;
+            ahead.read_ahead = true;
+            auto reader = telemetry::TelemetryReader::open(file, ahead, logger);
+            std::span<const std::uint8_t> pkt;
+            suite.run("reader_read_next_read_ahead", framed, 1, [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    if (!reader.read_next(pkt)) {
+                        reader.seek_to_record(0);
+                        reader.read_next(pkt);
+                    }
+                    bench::do_not_optimize(pkt.data());
+                }
+            });
+        }
+
+        {
+            telemetry::TelemetryReader::Options uring;
+            uring.io_uring = true;
+            auto reader = telemetry::TelemetryReader::open(file, uring, logger);
+            std::span<const std::uint8_t> pkt;
+            suite.run("reader_read_next_io_uring", framed, 1, [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    if (!reader.read_next(pkt)) {
+                        reader.seek_to_record(0);
+                        reader.read_next(pkt);
+                    }
+                    bench::do_not_optimize(pkt.data());
+                }
+            });
+        }
+
+        {
+            // Items are records; each op is one batch of up to 256
+            auto reader = telemetry::TelemetryReader::open(file, logger);
+            telemetry::PacketBatch batch;
+            suite.run("reader_read_batch_256", framed * 256, 256, [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    if (!reader.read_batch(batch, 256, 1 << 20)) {
+                        reader.seek_to_record(0);
+                        reader.read_batch(batch, 256, 1 << 20);
+                    }
+                    bench::do_not_optimize(batch.arena().data());
+                }
+            });
+        }
+
+        {
+            std::optional<telemetry::MappedTelemetryReader> reader;
+            reader.emplace(telemetry::MappedTelemetryReader::open(file, logger));
+            std::span<const std::uint8_t> pkt;
+            suite.run("mapped_reader_next", framed, 1, [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    if (!reader->next(pkt)) {
+                        reader.emplace(telemetry::MappedTelemetryReader::open(file, logger));
+                        reader->next(pkt);
+                    }
+                    bench::do_not_optimize(pkt.data());
+                }
+            });
+        }
+        fs::remove(file);
+    }
+
+    // ---- End to end ----
+
+    void bench_simulator(bench::Suite& suite, telemetry::Logger& logger) {
+        const std::size_t frames = 1000;
+        const std::size_t framed = encoded_frame().size() + 8;
+
+        suite.run("simulator_run_1000_frames", frames * framed, frames, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                telemetry::TelemetryRecorder rec(kWorkDir / "sim.bin", logger,
+                                                 telemetry::TelemetryRecorder::OpenMode::Truncate);
+                telemetry_sim::TelemetrySimulator::Config config;
+                config.packet_count = frames;
+                config.end_time_ms = config.start_time_ms + frames * config.step_ms;
+                telemetry_sim::TelemetrySimulator sim(config, rec, logger);
+                sim.run();
+            }
+        });
+        fs::remove(kWorkDir / "sim.bin");
+    }
+
+    // ---- Float column compression on simulator output ----
+
+    // Frames of a deterministic simulator run (the default Config, seed 42)
+    telemetry_sim::TelemetryFrameBatch simulate_frames(telemetry::Logger& logger, std::size_t frames) {
+        telemetry::TelemetryRecorder rec(kWorkDir / "sim_frames.bin", logger,
+                                         telemetry::TelemetryRecorder::OpenMode::Truncate);
+        telemetry_sim::TelemetrySimulator::Config config;
+        config.packet_count = frames;
+        config.end_time_ms = config.start_time_ms + frames * config.step_ms;
+        telemetry_sim::TelemetrySimulator sim(config, rec, logger, true);
+        sim.run();
+        fs::remove(kWorkDir / "sim_frames.bin");
+        return sim.get_batch();
+    }
+
+    struct FloatColumn {
+        const char* name;
+        std::span<const float> values;
+    };
+
+    std::vector<FloatColumn> float_columns(const telemetry_sim::TelemetryFrameBatch& batch) {
+        return {{"temperature_c", batch.temperature_c()}, {"voltage_v", batch.voltage_v()},
+                {"position_x", batch.position_x()},       {"position_y", batch.position_y()},
+                {"velocity_mps", batch.velocity_mps()}};
+    }
+
+    // XOR float codec over the five float columns of 4096 simulated frames.
+    // Bytes are the raw float bytes, so MB/s is uncompressed throughput.
+    void bench_float_codec(bench::Suite& suite, telemetry::Logger& logger) {
+        const std::size_t frames = 4096;
+        const auto batch = simulate_frames(logger, frames);
+        const auto columns = float_columns(batch);
+        const std::size_t raw_bytes = columns.size() * frames * sizeof(float);
+
+        telemetry::BitWriter bw;
+        std::vector<std::vector<std::uint8_t>> encoded;
+        for (const auto& column : columns) {
+            bw.clear();
+            telemetry::encode_float_column(column.values, bw);
+            auto bytes = bw.finish();
+            encoded.emplace_back(bytes.begin(), bytes.end());
+        }
+
+        suite.run("float_xor_encode_sim_5x4096", raw_bytes, columns.size() * frames, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                for (const auto& column : columns) {
+                    bw.clear();
+                    telemetry::encode_float_column(column.values, bw);
+                    bench::do_not_optimize(bw.finish().data());
+                }
+            }
+        });
+
+        std::vector<float> out(frames);
+        suite.run("float_xor_decode_sim_5x4096", raw_bytes, columns.size() * frames, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                for (const auto& bytes : encoded) {
+                    telemetry::BitReader br(bytes);
+                    telemetry::decode_float_column(br, out);
+                    bench::do_not_optimize(out.data());
+                }
+            }
+        });
+    }
+
+    // Compression ratio per column of a simulator run
+    void print_float_codec_table() {
+        const std::size_t frames = 65536;
+        fs::create_directories(kWorkDir);
+        telemetry::Logger logger((kWorkDir / "bench.log").string(), telemetry::LogLevel::Warn, false);
+        const auto batch = simulate_frames(logger, frames);
+
+        std::cout << "XOR float codec on " << frames << " simulated frames\n\n";
+        std::cout << std::setw(15) << "column" << std::setw(12) << "raw B" << std::setw(12) << "encoded B"
+                  << std::setw(10) << "bits/val" << std::setw(8) << "ratio" << "\n";
+        std::cout << std::string(57, '-') << "\n";
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::size_t raw_total = 0;
+        std::size_t encoded_total = 0;
+        telemetry::BitWriter bw;
+        for (const auto& column : float_columns(batch)) {
+            bw.clear();
+            telemetry::encode_float_column(column.values, bw);
+            const std::size_t raw = column.values.size_bytes();
+            const std::size_t encoded = bw.finish().size();
+            raw_total += raw;
+            encoded_total += encoded;
+            std::cout << std::setw(15) << column.name << std::setw(12) << raw << std::setw(12) << encoded
+                      << std::setw(10) << 8.0 * static_cast<double>(encoded) / static_cast<double>(frames)
+                      << std::setw(8) << static_cast<double>(raw) / static_cast<double>(encoded) << "\n";
+        }
+        std::cout << std::setw(15) << "total" << std::setw(12) << raw_total << std::setw(12) << encoded_total
+                  << std::setw(10) << 8.0 * static_cast<double>(encoded_total) / static_cast<double>(5 * frames)
+                  << std::setw(8) << static_cast<double>(raw_total) / static_cast<double>(encoded_total) << "\n";
+    }
+
+    // ---- Block compression on simulator output ----
+
+    void record_simulation(const fs::path& path, telemetry::Logger& logger, std::size_t frames,
+                           const telemetry::TelemetryRecorder::Options& opt) {
+        telemetry::TelemetryRecorder rec(path, logger, telemetry::TelemetryRecorder::OpenMode::Truncate, opt);
+        telemetry_sim::TelemetrySimulator::Config config;
+        config.packet_count = frames;
+        config.end_time_ms = config.start_time_ms + frames * config.step_ms;
+        telemetry_sim::TelemetrySimulator sim(config, rec, logger);
+        sim.run();
+    }
+
+    // LZ on one default-size block of simulator records, and replay of a
+    // block-compressed recording. Bytes are raw (uncompressed) record bytes.
+    void bench_block_codec(bench::Suite& suite, telemetry::Logger& logger) {
+        const fs::path plain = kWorkDir / "plain_sim.bin";
+        const fs::path blocks = kWorkDir / "block_sim.bin";
+        const std::size_t frames = 16384;
+        const std::size_t framed = telemetry_sim::TelemetryFrame::kEncodedSize + 8;
+
+        record_simulation(plain, logger, frames, {});
+        std::vector<std::uint8_t> raw;
+        {
+            std::ifstream in(plain, std::ios::binary);
+            raw.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        }
+        raw.erase(raw.begin(), raw.begin() + telemetry::format::kHeaderSize);
+        raw.resize(std::min(raw.size(), telemetry::format::kDefaultBlockBytes));
+
+        std::vector<std::uint8_t> packed(telemetry::lz_compress_bound(raw.size()));
+        suite.run("lz_compress_sim_block", raw.size(), 1, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                bench::do_not_optimize(telemetry::lz_compress(raw, packed));
+            }
+        });
+
+        packed.resize(telemetry::lz_compress(raw, packed));
+        std::vector<std::uint8_t> restored(raw.size());
+        suite.run("lz_decompress_sim_block", raw.size(), 1, [&](std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                bench::do_not_optimize(telemetry::lz_decompress(packed, restored));
+            }
+        });
+
+        telemetry::TelemetryRecorder::Options opt;
+        opt.compress_blocks = true;
+        record_simulation(blocks, logger, frames, opt);
+        {
+            auto reader = telemetry::TelemetryReader::open(blocks, logger);
+            std::vector<std::uint8_t> pkt;
+            suite.run("reader_read_next_blocks", framed, 1, [&](std::size_t n) {
+                for (std::size_t i = 0; i < n; i++) {
+                    if (!reader.read_next(pkt)) {
+                        reader.seek_to_record(0);
+                        reader.read_next(pkt);
+                    }
+                    bench::do_not_optimize(pkt.data());
+                }
+            });
+        }
+        fs::remove(plain);
+        fs::remove(blocks);
+    }
+
+    // File size of a simulator run per layout, relative to plain records
+    void print_block_codec_table() {
+        const std::size_t frames = 65536;
+        fs::create_directories(kWorkDir);
+        telemetry::Logger logger((kWorkDir / "bench.log").string(), telemetry::LogLevel::Warn, false);
+        const fs::path file = kWorkDir / "layout_sim.bin";
+
+        struct Layout {
+            const char* name;
+            std::uint16_t payload_flags;
+            bool blocks;
+        };
+        const Layout layouts[] = {
+            {"plain", 0, false},
+            {"plain+blocks", 0, true},
+            {"compact", telemetry::format::kFlagCompactFrames, false},
+            {"compact+blocks", telemetry::format::kFlagCompactFrames, true},
+        };
+
+        std::cout << "Recording layouts for " << frames << " simulated frames (index interval 1024)\n\n";
+        std::cout << std::setw(16) << "layout" << std::setw(12) << "bytes" << std::setw(10) << "B/frame"
+                  << std::setw(8) << "ratio" << "\n";
+        std::cout << std::string(46, '-') << "\n";
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::uintmax_t plain_bytes = 0;
+        for (const auto& layout : layouts) {
+            telemetry::TelemetryRecorder::Options opt;
+            opt.index_interval = 1024;
+            opt.payload_flags = layout.payload_flags;
+            opt.compress_blocks = layout.blocks;
+            record_simulation(file, logger, frames, opt);
+            const std::uintmax_t bytes = fs::file_size(file);
+            if (plain_bytes == 0) {
+                plain_bytes = bytes;
+            }
+            std::cout << std::setw(16) << layout.name << std::setw(12) << bytes
+                      << std::setw(10) << static_cast<double>(bytes) / static_cast<double>(frames)
+                      << std::setw(8) << static_cast<double>(plain_bytes) / static_cast<double>(bytes) << "\n";
+        }
+        fs::remove(file);
+    }
+
+    // ---- Cold-cache replay (page cache dropped before each pass) ----
+
+    // Asks the kernel to drop the file's cached pages. Returns false if it
+    // cannot (e.g. tmpfs keeps them), in which case the pass is warm.
+    bool evict_page_cache(const fs::path& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        ::fdatasync(fd);
+        bool ok = ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        ::close(fd);
+        return ok;
+    }
+
+    void print_cold_replay_table() {
+        const std::size_t packets = 2'000'000;
+        fs::create_directories(kWorkDir);
+        telemetry::Logger logger((kWorkDir / "bench.log").string(), telemetry::LogLevel::Warn, false);
+        const fs::path file = kWorkDir / "cold_replay.bin";
+        record_frames(file, logger, packets);
+        const double mb = static_cast<double>(fs::file_size(file)) / 1e6;
+
+        struct Mode {
+            const char* name;
+            bool read_ahead;
+            bool io_uring;
+        };
+        const Mode modes[] = {{"read_next", false, false},
+                              {"read_next + read-ahead", true, false},
+                              {"read_next + io_uring", false, true}};
+
+        std::cout << "Replay + deserialize of " << packets << " frames (" << std::fixed << std::setprecision(1)
+                  << mb << " MB), page cache dropped before each pass\n\n";
+        std::cout << std::setw(26) << "mode" << std::setw(10) << "ms" << std::setw(10) << "MB/s" << "\n";
+        std::cout << std::string(46, '-') << "\n";
+
+        for (const auto& mode : modes) {
+            if (!evict_page_cache(file)) {
+                std::cout << "(could not drop cached pages; pass is warm)\n";
+            }
+            auto start = std::chrono::steady_clock::now();
+            telemetry::TelemetryReader::Options opt;
+            opt.read_ahead = mode.read_ahead;
+            opt.io_uring = mode.io_uring;
+            auto reader = telemetry::TelemetryReader::open(file, opt, logger);
+            std::span<const std::uint8_t> pkt;
+            telemetry_sim::TelemetryFrame frame;
+            while (reader.read_next(pkt)) {
+                telemetry::PacketReader pr(pkt);
+                frame.deserialize(pr);
+                bench::do_not_optimize(frame);
+            }
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            std::cout << std::setw(26) << mode.name << std::setw(10) << ms << std::setw(10) << mb / (ms / 1e3) << "\n";
+        }
+        fs::remove(file);
+    }
+
+    // ---- CRC engine comparison table (GB/s per engine and size) ----
+
+    void print_crc_engine_table() {
+        using clock = std::chrono::steady_clock;
+        const std::size_t sizes[] = {36, 256, 4 * 1024, 64 * 1024, 1024 * 1024};
+        const telemetry::Crc32Engine engines[] = {
+            telemetry::Crc32Engine::Bitwise,
+            telemetry::Crc32Engine::Slice8,
+            telemetry::Crc32Engine::Slice16,
+            telemetry::Crc32Engine::Pclmul,
+        };
+
+        std::mt19937 rng(42);
+        std::vector<std::uint8_t> buffer(sizes[std::size(sizes) - 1]);
+        for (auto& b : buffer) {
+            b = static_cast<std::uint8_t>(rng());
+        }
+
+        std::cout << "crc32 throughput (GB/s), active engine: "
+                  << telemetry::to_string(telemetry::crc32_active_engine()) << "\n\n";
+
+        std::cout << std::setw(10) << "bytes";
+        for (auto engine : engines) {
+            std::cout << std::setw(10) << telemetry::to_string(engine);
+        }
+        std::cout << "\n" << std::string(50, '-') << "\n";
+
+        std::cout << std::fixed << std::setprecision(2);
+        for (std::size_t size : sizes) {
+            std::span<const std::uint8_t> data(buffer.data(), size);
+            std::cout << std::setw(10) << size;
+            for (auto engine : engines) {
+                if (!telemetry::crc32_engine_supported(engine)) {
+                    std::cout << std::setw(10) << "n/a";
+                    continue;
+                }
+                // Aim for roughly 256 MiB of work per engine (less for the slow bitwise loop)
+                std::size_t target_bytes = (engine == telemetry::Crc32Engine::Bitwise) ? (16u << 20) : (256u << 20);
+                std::size_t iterations = std::max<std::size_t>(1, target_bytes / size);
+
+                auto start = clock::now();
+                for (std::size_t i = 0; i < iterations; i++) {
+                    bench::do_not_optimize(telemetry::crc32(data, engine));
+                }
+                double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+                std::cout << std::setw(10) << static_cast<double>(size * iterations) / elapsed / 1e9;
+            }
+            std::cout << "\n";
+        }
+    }
+
+    void print_usage(const char* argv0) {
+        std::cerr << "Usage: " << argv0 << " [--json FILE] [--filter TEXT] [--min-time SECONDS] [--crc-engines] [--float-codec] [--block-codec] [--cold-replay]\n";
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    bench::Options opt;
+    std::string json_path;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json" && i + 1 < argc) {
+            json_path = argv[++i];
+        } else if (arg == "--filter" && i + 1 < argc) {
+            opt.filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            opt.min_time_s = std::stod(argv[++i]);
+        } else if (arg == "--crc-engines") {
+            print_crc_engine_table();
+            return 0;
+        } else if (arg == "--float-codec") {
+            print_float_codec_table();
+            return 0;
+        } else if (arg == "--block-codec") {
+            print_block_codec_table();
+            return 0;
+        } else if (arg == "--cold-replay") {
+            print_cold_replay_table();
+            return 0;
+        } else {
+            print_usage(argv[0]);
+            return 2;
+        }
+    }
+
+    fs::create_directories(kWorkDir);
+    // Warn level: the per-packet Info lines are filtered before formatting,
+    // as they would be in a production run.
+    telemetry::Logger logger((kWorkDir / "bench.log").string(), telemetry::LogLevel::Warn, false);
+
+    bench::Suite suite(opt);
+    std::cerr << "Running telemetry_lib benchmarks...\n";
+    bench_codec(suite);
+    bench_corrupt_decode(suite);
+    bench_batch_decode(suite);
+    bench_compact_codec(suite);
+    bench_float_codec(suite, logger);
+    bench_block_codec(suite, logger);
+    bench_column_scan(suite);
+    bench_crc(suite);
+    bench_recorder(suite, logger);
+    bench_replay(suite, logger);
+    bench_simulator(suite, logger);
+
+    std::cout << "\n";
+    suite.print_table(std::cout);
+
+    if (!json_path.empty()) {
+        std::ofstream out(json_path);
+        if (!out) {
+            std::cerr << "failed to open " << json_path << "\n";
+            return 1;
+        }
+        suite.write_json(out);
+        std::cout << "\nwrote " << json_path << "\n";
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <utility>
+
+#include "bench/Harness.h"
+
+namespace bench {
+
+    namespace {
+
+        using clock = std::chrono::steady_clock;
+
+        constexpr double kMinBatchNs = 20'000.0;
+
+        double elapsed_ns(clock::time_point start) {
+            return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        }
+
+        double percentile(std::vector<double>& sorted, double p) {
+            std::size_t index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+            return sorted[std::min(index, sorted.size() - 1)];
+        }
+
+        // JSON string escaping for benchmark names (plain ASCII in practice)
+        std::string quoted(const std::string& text) {
+            std::string out = "\"";
+            for (char c : text) {
+                if (c == '"' || c == '\\') {
+                    out += '\\';
+                }
+                out += c;
+            }
+            return out + "\"";
+        }
+
+    }
+
+    Suite::Suite(Options opt)
+        : opt_(std::move(opt))
+        {}
+
+    void Suite::run(const std::string& name,
+                    std::size_t bytes_per_op,
+                    std::size_t items_per_op,
+                    const std::function<void(std::size_t)>& op) {
+        if (!opt_.filter.empty() && name.find(opt_.filter) == std::string::npos) {
+            return;
+        }
+
+        // ---- Calibrate: grow the batch until one batch takes >= kMinBatchNs ----
+        std::size_t batch = 1;
+        while (true) {
+            auto start = clock::now();
+            op(batch);
+            double ns = elapsed_ns(start);
+            if (ns >= kMinBatchNs || batch >= (std::size_t{1} << 30)) {
+                break;
+            }
+            batch *= (ns < kMinBatchNs / 16) ? 8 : 2;
+        }
+
+        // ---- Sample until both the time and sample-count minimums are met ----
+        std::vector<double> per_op_ns;
+        double total_ns = 0.0;
+        const double min_ns = opt_.min_time_s * 1e9;
+        while (total_ns < min_ns || per_op_ns.size() < opt_.min_samples) {
+            auto start = clock::now();
+            op(batch);
+            double ns = elapsed_ns(start);
+            total_ns += ns;
+            per_op_ns.push_back(ns / static_cast<double>(batch));
+
+            // Slow operations (whole simulator runs) stop at 10x the time budget
+            if (total_ns >= 10 * min_ns && per_op_ns.size() >= 10) {
+                break;
+            }
+        }
+
+        Result r;
+        r.name = name;
+        r.batch = batch;
+        r.ops = static_cast<std::uint64_t>(batch) * per_op_ns.size();
+        r.ns_per_op = total_ns / static_cast<double>(r.ops);
+        std::sort(per_op_ns.begin(), per_op_ns.end());
+        r.p50_ns = percentile(per_op_ns, 0.50);
+        r.p99_ns = percentile(per_op_ns, 0.99);
+        r.mb_per_s = static_cast<double>(bytes_per_op) * 1e3 / r.ns_per_op;
+        r.items_per_s = static_cast<double>(items_per_op) * 1e9 / r.ns_per_op;
+
+        std::cerr << "  " << std::left << std::setw(32) << name << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(12) << r.ns_per_op << " ns/op\n";
+        results_.push_back(std::move(r));
+    }
+
+    void Suite::print_table(std::ostream& out) const {
+        out << std::left << std::setw(32) << "benchmark" << std::right
+            << std::setw(14) << "ns/op"
+            << std::setw(12) << "p50 ns"
+            << std::setw(12) << "p99 ns"
+            << std::setw(12) << "MB/s"
+            << std::setw(14) << "items/s" << "\n"
+            << std::string(96, '-') << "\n";
+
+        out << std::fixed;
+        for (const auto& r : results_) {
+            out << std::left << std::setw(32) << r.name << std::right << std::setprecision(1)
+                << std::setw(14) << r.ns_per_op
+                << std::setw(12) << r.p50_ns
+                << std::setw(12) << r.p99_ns
+                << std::setw(12) << r.mb_per_s
+                << std::setprecision(0) << std::setw(14) << r.items_per_s << "\n";
+        }
+    }
+
+    void Suite::write_json(std::ostream& out) const {
+        out << "{\n  \"suite\": \"telemetry_lib\",\n  \"benchmarks\": [\n";
+        out << std::fixed << std::setprecision(3);
+        for (std::size_t i = 0; i < results_.size(); i++) {
+            const auto& r = results_[i];
+            out << "    {\"name\": " << quoted(r.name)
+                << ", \"ops\": " << r.ops
+                << ", \"batch\": " << r.batch
+                << ", \"ns_per_op\": " << r.ns_per_op
+                << ", \"p50_ns\": " << r.p50_ns
+                << ", \"p99_ns\": " << r.p99_ns
+                << ", \"mb_per_s\": " << r.mb_per_s
+                << ", \"items_per_s\": " << r.items_per_s << "}"
+                << (i + 1 < results_.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+
+} // namespace bench
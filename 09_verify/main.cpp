@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "telemetry/Logger.h"
+#include "telemetry/Verify.h"
+
+// Whole-file CRC verification of telemetry recordings.
+//
+// Usage: telemetry_verify [--threads N] [--max-packet BYTES] FILE...
+// Exit status: 0 all files OK, 1 at least one file failed, 2 usage error.
+
+namespace {
+
+    void print_usage(const char* argv0) {
+        std::cerr << "Usage: " << argv0 << " [--threads N] [--max-packet BYTES] FILE...\n"
+                  << "  --threads N         worker threads (default: all cores, 1 = sequential)\n"
+                  << "  --max-packet BYTES  largest accepted payload (default: 65536)\n";
+    }
+
+    bool parse_count(const std::string& text, unsigned long& out) {
+        if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+            return false;
+        }
+        out = std::stoul(text);
+        return true;
+    }
+
+    void print_report(const std::string& file, const telemetry::VerifyReport& report) {
+        std::cout << file << ": " << (report.ok() ? "OK" : "FAILED") << "\n"
+                  << "  records     " << report.records << "\n"
+                  << "  bad records " << report.bad_records << "\n";
+        if (report.bad_blocks != 0) {
+            std::cout << "  bad blocks  " << report.bad_blocks << "\n";
+        }
+        if (!report.ok()) {
+            std::cout << "  first error " << report.error << " (record " << report.error_record
+                      << ", offset " << report.error_offset << ")\n";
+        }
+        std::cout << std::fixed << std::setprecision(1)
+                  << "  throughput  " << report.throughput_mb_s() << " MB/s ("
+                  << report.bytes << " bytes, " << report.threads << " threads, "
+                  << std::setprecision(3)
+                  << std::chrono::duration<double, std::milli>(report.elapsed).count() << " ms)\n";
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    telemetry::VerifyOptions opt;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        unsigned long value = 0;
+        if ((arg == "--threads" || arg == "--max-packet") && i + 1 < argc) {
+            if (!parse_count(argv[++i], value)) {
+                print_usage(argv[0]);
+                return 2;
+            }
+            if (arg == "--threads") {
+                opt.threads = static_cast<unsigned>(value);
+            } else {
+                opt.max_packet_size = value;
+            }
+        } else if (arg.rfind("--", 0) == 0) {
+            print_usage(argv[0]);
+            return 2;
+        } else {
+            files.push_back(arg);
+        }
+    }
+
+    if (files.empty()) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    telemetry::Logger logger("verify.log", telemetry::LogLevel::Info, false);
+
+    bool all_ok = true;
+    for (const auto& file : files) {
+        auto report = telemetry::verify_recording(file, opt, logger);
+        print_report(file, report);
+        all_ok = all_ok && report.ok();
+    }
+
+    return all_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace telemetry {
+
+    // std::allocator that hands out Alignment-aligned storage (cache lines for
+    // SIMD columns, disk sectors for direct I/O buffers):
+    //
+    //   std::vector<float, AlignedAllocator<float, 64>> column;
+    template <class T, std::size_t Alignment>
+    struct AlignedAllocator {
+        static_assert(Alignment >= alignof(T) && (Alignment & (Alignment - 1)) == 0,
+                      "Alignment must be a power of two no smaller than alignof(T)");
+
+        using value_type = T;
+
+        template <class U>
+        struct rebind {
+            using other = AlignedAllocator<U, Alignment>;
+        };
+
+        AlignedAllocator() noexcept = default;
+
+        template <class U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        T* allocate(std::size_t n) {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+                throw std::bad_array_new_length();
+            }
+            return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{Alignment}));
+        }
+
+        void deallocate(T* p, std::size_t) noexcept {
+            ::operator delete(p, std::align_val_t{Alignment});
+        }
+
+        template <class U>
+        bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    };
+
+} // namespace telemetry
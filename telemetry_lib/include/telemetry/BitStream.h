@@ -0,0 +1,127 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "telemetry/ByteOrder.h"
+
+namespace telemetry {
+
+    // Bit-granular companions to PacketWriter / PacketReader for codecs that pack
+    // values into fewer than 8 bits (e.g. FloatXorCodec). Bits are written most
+    // significant first, so a stream reads left to right in a hex dump, and the
+    // finished bytes can be embedded in a packet with PacketWriter::add_bytes.
+    class BitWriter {
+        public:
+            BitWriter() = default;
+
+            // Appends the low count bits of value (count <= 64), high bit first.
+            void write_bits(std::uint64_t value, unsigned count) {
+                if (count == 0) {
+                    return;
+                }
+                if (count < 64) {
+                    value &= (std::uint64_t{1} << count) - 1;
+                }
+                // The accumulator fills from the top; used_ < 64 between calls
+                const unsigned free = 64 - used_;
+                if (count < free) {
+                    acc_ |= value << (free - count);
+                    used_ += count;
+                    return;
+                }
+                acc_ |= value >> (count - free);
+                flush_word();
+                count -= free;
+                acc_ = count == 0 ? 0 : value << (64 - count);
+                used_ = count;
+            }
+
+            void write_bit(bool bit) { write_bits(bit ? 1 : 0, 1); }
+
+            // Pads the last partial byte with zero bits and returns every byte
+            // written. Further writes continue after the padding.
+            std::span<const std::uint8_t> finish();
+
+            // Bits written so far (excluding finish() padding)
+            std::size_t bit_count() const noexcept { return buffer_.size() * 8 + used_ - padding_; }
+
+            void clear() noexcept;
+            void reserve(std::size_t bytes) { buffer_.reserve(bytes); }
+
+        private:
+            std::vector<std::uint8_t> buffer_;   // completed bytes
+            std::uint64_t acc_ = 0;              // pending bits, left-aligned
+            unsigned used_ = 0;                  // number of pending bits
+            std::size_t padding_ = 0;            // zero bits added by finish() calls
+
+            // Appends the 8 accumulator bytes and empties it.
+            void flush_word();
+    };
+
+    // Reads a BitWriter stream. Reading past the end throws std::out_of_range
+    // (the reader is unchanged), as PacketReader does.
+    class BitReader {
+        public:
+            explicit BitReader(std::span<const std::uint8_t> bytes) noexcept
+                : data_(bytes) {}
+
+            // Next count bits (count <= 64) as an unsigned value.
+            std::uint64_t read_bits(unsigned count) {
+                if (count == 0) {
+                    return 0;
+                }
+                if (count > remaining_bits()) [[unlikely]] {
+                    throw_exhausted();
+                }
+                if (count > 56) {
+                    // A 64-bit window holds at least 57 bits past any bit offset
+                    std::uint64_t high = read_bits(count - 32);
+                    return (high << 32) | read_bits(32);
+                }
+                const std::uint64_t window = load_window(pos_ / 8) << (pos_ % 8);
+                pos_ += count;
+                return window >> (64 - count);
+            }
+
+            bool read_bit() { return read_bits(1) != 0; }
+
+            // Next count bits (count <= 57) without consuming them; bits past the
+            // end read as zero. Lets a decoder branch on a prefix, then read_bits
+            // the whole code at once.
+            std::uint64_t peek_bits(unsigned count) const noexcept {
+                if (count == 0) {
+                    return 0;
+                }
+                return (load_window(pos_ / 8) << (pos_ % 8)) >> (64 - count);
+            }
+
+            std::size_t remaining_bits() const noexcept { return data_.size() * 8 - pos_; }
+
+            // Bit offset from the start of the stream
+            std::size_t position() const noexcept { return pos_; }
+
+        private:
+            std::span<const std::uint8_t> data_;
+            std::size_t pos_ = 0;
+
+            // Big-endian 8 bytes starting at data_[byte]; missing bytes read as zero.
+            std::uint64_t load_window(std::size_t byte) const noexcept {
+                if (data_.size() - byte < sizeof(std::uint64_t)) [[unlikely]] {
+                    return load_tail(byte);
+                }
+                std::uint64_t window;
+                std::memcpy(&window, data_.data() + byte, sizeof(window));
+                return std::endian::native == std::endian::big ? window : byteswap(window);
+            }
+
+            std::uint64_t load_tail(std::size_t byte) const noexcept;
+
+            [[noreturn]] static void throw_exhausted();
+    };
+
+} // namespace telemetry
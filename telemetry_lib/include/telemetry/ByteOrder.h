@@ -0,0 +1,50 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <type_traits>
+
+namespace telemetry {
+
+    // C++20 stand-in for std::byteswap (C++23); compiles to a single bswap/rev.
+    template <std::unsigned_integral T>
+    constexpr T byteswap(T value) noexcept {
+        if constexpr (sizeof(T) == 1) {
+            return value;
+        } else if constexpr (sizeof(T) == 2) {
+            return static_cast<T>(__builtin_bswap16(value));
+        } else if constexpr (sizeof(T) == 4) {
+            return static_cast<T>(__builtin_bswap32(value));
+        } else {
+            static_assert(sizeof(T) == 8, "unsupported integer width");
+            return static_cast<T>(__builtin_bswap64(value));
+        }
+    }
+
+    // Fixed-width scalars the packet codecs can encode: integers and IEEE floats.
+    template <class T>
+    concept PacketScalar = (std::is_integral_v<T> || std::is_floating_point_v<T>) &&
+                           !std::is_same_v<T, bool> &&
+                           (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+    // Unsigned integer with the same width as T (the scalar's bit pattern).
+    template <PacketScalar T>
+    using scalar_bits_t = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                          std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                          std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+    // Bit pattern of value, byte-swapped if swap is set.
+    template <PacketScalar T>
+    inline scalar_bits_t<T> scalar_to_bits(T value, bool swap) noexcept {
+        auto bits = std::bit_cast<scalar_bits_t<T>>(value);
+        return swap ? byteswap(bits) : bits;
+    }
+
+    // Inverse of scalar_to_bits: value from its (possibly byte-swapped) bit pattern.
+    template <PacketScalar T>
+    inline T bits_to_scalar(scalar_bits_t<T> bits, bool swap) noexcept {
+        return std::bit_cast<T>(swap ? byteswap(bits) : bits);
+    }
+
+} // namespace telemetry
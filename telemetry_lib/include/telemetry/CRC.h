@@ -5,6 +5,57 @@
 
 namespace telemetry {
 
+    // CRC-32 used by the TLRY format:
+    //   poly 0x04C11DB7, MSB-first (non-reflected), init 0xFFFFFFFF, xorout 0xFFFFFFFF.
+    // Every engine below produces bit-identical results.
+    enum class Crc32Engine {
+        Bitwise,  // reference bit-at-a-time loop (original implementation)
+        Slice8,   // slicing-by-8 lookup tables
+        Slice16,  // slicing-by-16 lookup tables
+        Pclmul    // x86 PCLMULQDQ carry-less multiply folding
+    };
+
+    // Computes the checksum with the fastest engine supported by the running CPU.
     std::uint32_t crc32(const std::span<const std::uint8_t>& data);
 
+    // Computes the checksum with a specific engine (benchmarks / cross-checks).
+    // An engine that is not supported on this CPU falls back to Slice16.
+    std::uint32_t crc32(const std::span<const std::uint8_t>& data, Crc32Engine engine);
+
+    // True if the engine can run on this CPU (runtime feature detection).
+    bool crc32_engine_supported(Crc32Engine engine) noexcept;
+
+    // Engine selected by crc32(data).
+    Crc32Engine crc32_active_engine() noexcept;
+
+    const char* to_string(Crc32Engine engine) noexcept;
+
+    // Incremental CRC-32 for data that arrives in several chunks
+    // (e.g. a header and a payload held in separate buffers):
+    //
+    //   Crc32 crc;
+    //   crc.update(header).update(payload);
+    //   crc.value() == crc32(header || payload)
+    class Crc32 {
+        public:
+            Crc32() noexcept = default;
+
+            // Feeds the next chunk (uses the fastest engine, like crc32()).
+            Crc32& update(std::span<const std::uint8_t> data) noexcept;
+
+            // Finalized checksum of everything fed so far. The accumulator stays usable.
+            std::uint32_t value() const noexcept;
+
+            // Starts a new checksum.
+            void reset() noexcept;
+
+        private:
+            std::uint32_t state_ = 0xFFFFFFFF;
+    };
+
+    // Merges the checksums of two adjacent chunks A and B:
+    //   crc32_combine(crc32(A), crc32(B), B.size()) == crc32(A || B)
+    // Runs in O(log len_b), so chunks of a large payload can be checksummed in parallel.
+    std::uint32_t crc32_combine(std::uint32_t crc_a, std::uint32_t crc_b, std::uint64_t len_b) noexcept;
+
 }
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "telemetry/AlignedAllocator.h"
+
+namespace telemetry {
+
+    // Append-only writer that bypasses the page cache (O_DIRECT). Bytes are
+    // staged in a kAlignment-aligned buffer and written in whole aligned blocks
+    // at aligned offsets, as O_DIRECT requires.
+    //
+    // The last partial block is written zero-padded by flush(), and the file is
+    // then truncated back to offset(), so the file never ends in padding. The
+    // partial block stays buffered and is rewritten in place by the next flush.
+    class DirectWriter {
+        public:
+            // Sector/page size every O_DIRECT transfer is aligned to
+            static constexpr std::size_t kAlignment = 4096;
+
+            // Opens the file with O_DIRECT and continues writing at `offset` (its
+            // current end; an unaligned end is read back so its block can be
+            // rewritten). buffer_bytes is rounded up to a multiple of kAlignment.
+            // Throws std::runtime_error if the file or filesystem rejects O_DIRECT.
+            DirectWriter(const std::filesystem::path& path,
+                         std::uint64_t offset,
+                         std::size_t buffer_bytes);
+
+            DirectWriter(const DirectWriter&) = delete;
+            DirectWriter& operator=(const DirectWriter&) = delete;
+
+            // Closes the file. Call flush() first: buffered bytes are dropped here.
+            ~DirectWriter();
+
+            // Appends bytes; every full buffer is written straight to the device.
+            // Throws std::runtime_error if a write fails.
+            void write(std::span<const std::uint8_t> bytes);
+
+            // Writes the buffered bytes (padded to kAlignment) and truncates the
+            // file to offset(). Throws std::runtime_error on failure.
+            void flush();
+
+            // File offset after the last byte accepted by write()
+            std::uint64_t offset() const noexcept { return base_ + fill_; }
+
+        private:
+            // Writes buffer_[0, bytes) at base_ (bytes is a multiple of kAlignment).
+            void write_aligned(std::size_t bytes);
+
+            int fd_ = -1;
+            std::vector<std::uint8_t, AlignedAllocator<std::uint8_t, kAlignment>> buffer_;
+            std::size_t fill_ = 0;      // bytes in buffer_
+            std::uint64_t base_ = 0;    // file offset of buffer_[0] (aligned)
+    };
+
+} // namespace telemetry
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "telemetry/BitStream.h"
+
+namespace telemetry {
+
+    // Lossless streaming codec for float series, after Gorilla (Pelkonen et al.
+    // 2015) with Chimp's (Liakos et al. 2022) control codes, for 32-bit floats.
+    // Each value is XORed with the previous one; neighbours share sign, exponent
+    // and often high mantissa bits, so the XOR starts with a run of zeros:
+    //
+    //   first value            32 raw bits
+    //   XOR == 0               '0'
+    //   leading ~ previous     '10'  + the XOR below the previous leading zeros
+    //   new leading count      '110' + 5-bit leading zeros + the XOR below them
+    //   > 5 trailing zeros     '111' + 5-bit leading zeros + 5-bit (length - 1) + length bits
+    //
+    // Repeated values cost 1 bit. Noise in the low mantissa bits costs
+    // 2 + (32 - leading zeros), where Gorilla's window test would usually fail and
+    // pay an 12-bit header. Values stay bit-exact (NaN payloads, -0.0f).
+    class FloatXorEncoder {
+        public:
+            void encode(float value, BitWriter& out);
+
+            // Starts a new series (the next value is written raw).
+            void reset() noexcept;
+
+        private:
+            std::uint32_t prev_ = 0;
+            unsigned leading_ = 32;       // no leading count yet ('10' cannot match)
+            bool first_ = true;
+    };
+
+    class FloatXorDecoder {
+        public:
+            // Throws std::out_of_range if the stream ends mid-value; the decoder
+            // and in are then unchanged.
+            float decode(BitReader& in);
+
+            void reset() noexcept;
+
+        private:
+            std::uint32_t prev_ = 0;
+            unsigned leading_ = 0;
+            bool first_ = true;
+    };
+
+    // Whole column in one call (one series, starting raw).
+    void encode_float_column(std::span<const float> values, BitWriter& out);
+
+    // Decodes out.size() values. Throws std::out_of_range if the stream is too short.
+    void decode_float_column(BitReader& in, std::span<float> out);
+
+} // namespace telemetry
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "telemetry/AlignedAllocator.h"
+#include "telemetry/ReadAhead.h"
+
+namespace telemetry {
+
+    // Minimal io_uring over the raw syscalls (no liburing): one submission and
+    // one completion ring mapped into the process, optional registered (fixed)
+    // buffers, and batched submission. Requests are queued with read()/write()
+    // and handed to the kernel together by one submit() call.
+    //
+    // Linux 5.1+ only. The constructor throws std::runtime_error if the kernel
+    // (or a seccomp policy / io_uring_disabled sysctl) refuses io_uring, so
+    // callers can fall back to plain reads and writes. Which requests the kernel
+    // implements is probed once per ring (can_read()/can_write()).
+    class IoUring {
+        public:
+            struct Completion {
+                std::uint64_t user_data = 0;
+                std::int32_t res = 0;   // bytes transferred, or -errno
+            };
+
+            explicit IoUring(unsigned entries);
+
+            IoUring(const IoUring&) = delete;
+            IoUring& operator=(const IoUring&) = delete;
+
+            // Unmaps the rings and closes the ring fd. Requests still in flight are
+            // waited for first so the kernel never writes into freed buffers.
+            ~IoUring();
+
+            // True if a ring can be created here and it implements reads and writes
+            // into unregistered buffers (Linux 5.6+), i.e. io_uring works whether or
+            // not register_buffers() succeeds. Probed once.
+            static bool available() noexcept;
+
+            // True if the kernel implements the request read()/write() queue for a
+            // registered (READ_FIXED/WRITE_FIXED, Linux 5.1+) or unregistered
+            // (READ/WRITE, Linux 5.6+) buffer. Unsupported requests fail with -EINVAL.
+            bool can_read(bool registered) const noexcept;
+            bool can_write(bool registered) const noexcept;
+
+            // Registers buffers for read()/write() with buffer >= 0 (READ_FIXED /
+            // WRITE_FIXED: pages are pinned once instead of on every request).
+            // Returns false if the kernel refuses (e.g. RLIMIT_MEMLOCK).
+            bool register_buffers(std::span<const std::span<std::uint8_t>> buffers);
+
+            // Queue one request; `buffer` is the registered buffer holding data, or
+            // -1 for an unregistered one. Returns false if the submission ring is full.
+            bool read(int fd, std::uint8_t* data, std::uint32_t size, std::uint64_t offset,
+                      std::uint64_t user_data, int buffer = -1);
+            bool write(int fd, const std::uint8_t* data, std::uint32_t size, std::uint64_t offset,
+                       std::uint64_t user_data, int buffer = -1);
+
+            // Hands every queued request to the kernel in one io_uring_enter and
+            // waits until at least wait_for completions are available.
+            // Throws std::runtime_error if the syscall fails.
+            void submit(unsigned wait_for = 0);
+
+            // Pops one completion if available.
+            bool poll(Completion& out) noexcept;
+
+            // Pops one completion, submitting queued requests and blocking if needed.
+            Completion wait();
+
+            unsigned queued() const noexcept { return queued_; }
+            unsigned in_flight() const noexcept { return in_flight_; }
+
+        private:
+            void close_ring() noexcept;
+            bool queue(std::uint8_t opcode, int fd, std::uint64_t addr, std::uint32_t size,
+                       std::uint64_t offset, std::uint64_t user_data, int buffer);
+
+            int fd_ = -1;
+            unsigned ops_ = 0;          // supported requests (kOp* bits in IoUring.cpp)
+            unsigned sq_entries_ = 0;
+            unsigned queued_ = 0;       // prepared, not yet submitted
+            unsigned in_flight_ = 0;    // submitted, completion not yet popped
+
+            void* sq_ring_ = nullptr;
+            std::size_t sq_ring_bytes_ = 0;
+            void* cq_ring_ = nullptr;   // == sq_ring_ with IORING_FEAT_SINGLE_MMAP
+            std::size_t cq_ring_bytes_ = 0;
+            void* sqes_ = nullptr;
+            std::size_t sqes_bytes_ = 0;
+
+            // Pointers into the mapped rings
+            unsigned* sq_head_ = nullptr;
+            unsigned* sq_tail_ = nullptr;
+            unsigned* sq_mask_ = nullptr;
+            unsigned* sq_array_ = nullptr;
+            unsigned* cq_head_ = nullptr;
+            unsigned* cq_tail_ = nullptr;
+            unsigned* cq_mask_ = nullptr;
+            void* cqes_ = nullptr;
+    };
+
+    // ChunkSource for TelemetryReader that keeps `buffers` consecutive chunk
+    // reads queued on an io_uring instead of running a read-ahead thread: the
+    // consumer resubmits the chunk it just finished with and only blocks when
+    // the next chunk in file order has not completed yet.
+    class UringReadAhead : public ChunkSource {
+        public:
+            // Opens the file and sets up the ring; reads never go past `end`.
+            // Throws std::runtime_error if either fails, or if the kernel cannot
+            // read into the chunk buffers (io_uring unavailable).
+            UringReadAhead(const std::filesystem::path& path,
+                           std::uint64_t end,
+                           std::size_t chunk_bytes,
+                           std::size_t buffers = 3);
+
+            // Waits for reads still in flight, then closes the file.
+            ~UringReadAhead() override;
+
+            void start(std::uint64_t offset) override;
+            std::span<const std::uint8_t> next() override;
+
+        private:
+            enum class SlotState { Idle, InFlight, Ready, Held };
+
+            struct Slot {
+                std::vector<std::uint8_t, AlignedAllocator<std::uint8_t, 4096>> data;
+                SlotState state = SlotState::Idle;
+                std::uint64_t offset = 0;   // file offset of data[0]
+                std::size_t want = 0;       // bytes requested
+                std::size_t size = 0;       // bytes read so far
+                int error = 0;              // errno of a failed read
+            };
+
+            // Queues a read of the next chunk into slot i (or leaves it Idle at the end).
+            void queue_read(std::size_t i);
+            // Queues the unread rest of slot i's chunk (after a short read).
+            void queue_rest(std::size_t i);
+            // Applies one completion to its slot.
+            void complete(const IoUring::Completion& c);
+            // Waits out every read in flight (their data is discarded).
+            void drain() noexcept;
+
+            int fd_ = -1;
+            std::uint64_t end_ = 0;
+            std::size_t chunk_bytes_ = 0;
+            IoUring ring_;
+            bool fixed_ = false;              // slots are registered buffers
+
+            std::vector<Slot> slots_;
+            std::size_t head_ = 0;            // next slot in file order
+            std::size_t held_ = 0;            // slot returned by the last next()
+            bool holding_ = false;
+            std::uint64_t read_offset_ = 0;   // offset of the next chunk to queue
+    };
+
+    // Writes an append-only stream at explicit offsets through io_uring, keeping
+    // up to `buffers` x `buffer_bytes` of writes in flight. Data is copied into
+    // registered staging buffers; each full buffer becomes one WRITE_FIXED
+    // request, and the requests of one write() call go out in a single submit.
+    class UringWriter {
+        public:
+            // Opens the file for writing at `offset` (its current end).
+            // Throws std::runtime_error if the file or the ring cannot be set up, or
+            // if the kernel cannot write from the staging buffers.
+            UringWriter(const std::filesystem::path& path,
+                        std::uint64_t offset,
+                        std::size_t buffer_bytes,
+                        std::size_t buffers);
+
+            UringWriter(const UringWriter&) = delete;
+            UringWriter& operator=(const UringWriter&) = delete;
+
+            // Waits for writes in flight and closes the file. Call flush() first:
+            // errors here are dropped.
+            ~UringWriter();
+
+            // Appends bytes (queued; written once a staging buffer fills).
+            // Throws std::runtime_error if an earlier write failed.
+            void write(std::span<const std::uint8_t> bytes);
+
+            // Writes the partial buffer and waits for every write to complete.
+            void flush();
+
+            // File offset after the last byte accepted by write()
+            std::uint64_t offset() const noexcept { return offset_ + fill_; }
+
+        private:
+            struct Slot {
+                std::vector<std::uint8_t, AlignedAllocator<std::uint8_t, 4096>> data;
+                bool busy = false;
+                std::uint64_t offset = 0;   // file offset of data[0]
+                std::size_t size = 0;       // bytes to write
+                std::size_t done = 0;       // bytes written so far
+            };
+
+            // Queues the current slot and moves on to a free one (waiting if needed).
+            void queue_current();
+            void queue_rest(std::size_t i);
+            // Reaps one completion; throws on a write error.
+            void reap();
+
+            int fd_ = -1;
+            IoUring ring_;
+            bool fixed_ = false;
+
+            std::vector<Slot> slots_;
+            std::size_t current_ = 0;     // slot being filled
+            std::size_t fill_ = 0;        // bytes in the current slot
+            std::uint64_t offset_ = 0;    // file offset of the current slot
+            int error_ = 0;               // errno of the first failed write
+    };
+
+} // namespace telemetry
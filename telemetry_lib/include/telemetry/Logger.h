@@ -1,50 +1,145 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <format>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 
 namespace telemetry {
 
-    // Log severity levels
+    // Log severity levels (declared in increasing severity)
     enum class LogLevel {
         Info,
         Warn,
         Error
     };
 
+    // Compile-time floor for the format-style API: calls below it compile to nothing.
+    // Build with -DTELEMETRY_LOG_MIN_LEVEL=1 to strip Info, =2 to keep only Error.
+#ifndef TELEMETRY_LOG_MIN_LEVEL
+#define TELEMETRY_LOG_MIN_LEVEL 0
+#endif
+
+    inline constexpr LogLevel kCompiledMinLevel = static_cast<LogLevel>(TELEMETRY_LOG_MIN_LEVEL);
+
     class Logger {
+        public:
+            // What an async caller does when the queue is full
+            enum class OverflowPolicy {
+                Block, // wait for the background thread to free a slot
+                Drop   // discard the message (counted in dropped_messages())
+            };
+
+            struct Options {
+                // Async mode: callers push entries into a bounded lock-free queue and a
+                // background thread formats and writes them in batches.
+                bool async = false;
+                std::size_t queue_capacity = 4096; // entries, rounded up to a power of two
+                OverflowPolicy overflow = OverflowPolicy::Block;
+            };
+
         private:
             std::ofstream file;
             LogLevel min_level;
             bool mirror_to_console_;
 
-            // Helper: returns formatted timestamp string
-            std::string make_timestamp() const;
+            // Sync mode: serializes writers so the logger can be shared between threads
+            std::mutex mutex_;
 
-            // Helper: convert level to numeric severity
-            static int severity(LogLevel level);
+            // Async mode: ring buffer + background writer (null in sync mode)
+            class AsyncQueue;
+            std::unique_ptr<AsyncQueue> async_;
+
+            // Helper: returns formatted timestamp string
+            static std::string make_timestamp(std::chrono::system_clock::time_point when);
 
             // Core logging function (does filtering + formatting)
             void log(const std::string& message, LogLevel level);
 
+            // Format-style API: the level checks run before any formatting, and the
+            // message is formatted into a reused per-thread buffer.
+            template <LogLevel Level, class... Args>
+            void log_format(std::format_string<Args...> fmt, Args&&... args) {
+                if constexpr (Level >= kCompiledMinLevel) {
+                    if (!enabled(Level)) {
+                        return;
+                    }
+                    thread_local std::string buffer;
+                    buffer.clear();
+                    std::format_to(std::back_inserter(buffer), fmt, std::forward<Args>(args)...);
+                    log(buffer, Level);
+                }
+            }
+
+            // Formats and writes one line (sync mode)
+            void write_line(LogLevel level, const std::string& timestamp, const std::string& message);
+
         public:
             // Constructor: opens log file
             Logger(const std::string& filename,
                     LogLevel minLevel,
                     bool mirrorToConsole = false);
 
-            // Destructor: closes file automatically
+            // Same, with async options
+            Logger(const std::string& filename,
+                    LogLevel minLevel,
+                    bool mirrorToConsole,
+                    Options opt);
+
+            // Destructor: drains queued entries (async mode), closes file automatically
             ~Logger();
 
+            Logger(const Logger&) = delete;
+            Logger& operator=(const Logger&) = delete;
+
             // Public API convenience methods
             void info(const std::string& message);
             void warn(const std::string& message);
             void error(const std::string& message);
 
+            // Lazy std::format-style overloads for hot paths:
+            //   logger.info("t={} pos=({}, {})", t, x, y);
+            // Nothing is formatted when the level is filtered out, and calls below
+            // kCompiledMinLevel are removed at compile time.
+            template <class... Args>
+                requires (sizeof...(Args) > 0)
+            void info(std::format_string<Args...> fmt, Args&&... args) {
+                log_format<LogLevel::Info>(fmt, std::forward<Args>(args)...);
+            }
+
+            template <class... Args>
+                requires (sizeof...(Args) > 0)
+            void warn(std::format_string<Args...> fmt, Args&&... args) {
+                log_format<LogLevel::Warn>(fmt, std::forward<Args>(args)...);
+            }
+
+            template <class... Args>
+                requires (sizeof...(Args) > 0)
+            void error(std::format_string<Args...> fmt, Args&&... args) {
+                log_format<LogLevel::Error>(fmt, std::forward<Args>(args)...);
+            }
+
+            // True if a message at this level would be written (compile-time + runtime filter).
+            // Lets callers skip work that only feeds a log line.
+            bool enabled(LogLevel level) const noexcept {
+                return level >= kCompiledMinLevel && level >= min_level && file.is_open();
+            }
+
+            // Async mode: waits until every entry logged so far is written and the
+            // background thread has flushed the file. Sync mode: flushes the file.
+            void flush();
+
+            // Entries discarded by OverflowPolicy::Drop
+            std::uint64_t dropped_messages() const;
+
             // Helper: convert enum to string label
             static const char* to_string(LogLevel level);
     };
 
 } // namespace telemetry
-
-
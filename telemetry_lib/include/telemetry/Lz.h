@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace telemetry {
+
+    // Self-contained LZ77 block codec in the LZ4 style, used for compressed
+    // recording blocks (format::kFlagBlockCompressed). A block is a run of sequences:
+    //
+    //   [token][literal length+][literals][u16 offset][match length+]
+    //
+    // token high nibble = literal length, low nibble = match length - 4; 15 means
+    // "more length bytes follow" (each adds 0-255, the last one is < 255). The offset is
+    // little endian, 1..65535 bytes back. The last sequence ends after its literals.
+    //
+    // Compression is one greedy pass with a 4-byte hash table; decompression is
+    // a copy loop, so it runs at memory speed rather than disk speed.
+
+    // Largest output lz_compress can produce for n input bytes.
+    constexpr std::size_t lz_compress_bound(std::size_t n) noexcept {
+        return n + n / 255 + 16;
+    }
+
+    // Compresses src into dst and returns the compressed size, or 0 if dst is too
+    // small (never with dst.size() >= lz_compress_bound(src.size())).
+    std::size_t lz_compress(std::span<const std::uint8_t> src, std::span<std::uint8_t> dst) noexcept;
+
+    // Restores exactly dst.size() bytes. Returns false if src is malformed or
+    // does not decode to exactly dst.size() bytes; never reads or writes out of bounds.
+    bool lz_decompress(std::span<const std::uint8_t> src, std::span<std::uint8_t> dst) noexcept;
+
+} // namespace telemetry
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace telemetry {
+
+    // Read-only memory mapping of a whole file (POSIX mmap).
+    // Move-only; the mapping is released on destruction.
+    class MappedFile {
+        public:
+            // Maps the file. Throws std::runtime_error if it cannot be opened or mapped.
+            // An empty file yields an empty mapping.
+            static MappedFile open(const std::filesystem::path& path);
+
+            MappedFile() noexcept = default;
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            MappedFile(MappedFile&& other) noexcept;
+            MappedFile& operator=(MappedFile&& other) noexcept;
+
+            ~MappedFile();
+
+            std::span<const std::uint8_t> bytes() const noexcept { return {data_, size_}; }
+            std::size_t size() const noexcept { return size_; }
+
+        private:
+            MappedFile(const std::uint8_t* data, std::size_t size) noexcept
+                : data_(data), size_(size) {}
+
+            void release() noexcept;
+
+            const std::uint8_t* data_ = nullptr;
+            std::size_t size_ = 0;
+    };
+
+} // namespace telemetry
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "telemetry/Logger.h"
+#include "telemetry/MappedFile.h"
+#include "telemetry/TelemetryReader.h"
+
+namespace telemetry {
+
+    // Zero-copy replay of a TLRY recording through a read-only memory mapping.
+    //
+    // Performs the same validation as TelemetryReader (magic, version, size
+    // limits, truncation, CRC) and throws the same ParseError messages, but
+    // next() hands out views into the mapping instead of copying each payload.
+    // Per-packet reads do not allocate or log; only open, EOF and errors are logged.
+    // An index footer (format::kFlagIndexed) is skipped, not parsed as records.
+    // Block-compressed files (format::kFlagBlockCompressed) are decompressed one
+    // block at a time into an internal buffer, so those views are not zero-copy.
+    class MappedTelemetryReader {
+        public:
+            using Options = TelemetryReader::Options;
+
+            // Map file + validate header. Throws ParseError on invalid format.
+            static MappedTelemetryReader open(const std::filesystem::path& path,
+                                              telemetry::Logger& logger);
+
+            static MappedTelemetryReader open(const std::filesystem::path& path,
+                                              Options opt,
+                                              telemetry::Logger& logger);
+
+            MappedTelemetryReader(const MappedTelemetryReader&) = delete;
+            MappedTelemetryReader& operator=(const MappedTelemetryReader&) = delete;
+
+            MappedTelemetryReader(MappedTelemetryReader&&) noexcept = default;
+            MappedTelemetryReader& operator=(MappedTelemetryReader&&) noexcept = delete;
+
+            ~MappedTelemetryReader() = default;
+
+            // Header info (after open()).
+            std::uint16_t version() const noexcept { return version_; }
+            std::uint16_t flags() const noexcept { return flags_; }
+
+            // Read next framed packet.
+            //
+            // Returns:
+            //   true  -> out_packet views the payload inside the mapping
+            //            (valid for the lifetime of this reader; for block-compressed
+            //            files only until the next call)
+            //   false -> clean EOF (no more records)
+            //
+            // Throws ParseError on corruption/truncation/oversized packet.
+            bool next(std::span<const std::uint8_t>& out_packet);
+
+            // File offset of the next record (of the next block in block mode).
+            std::size_t offset() const noexcept { return offset_; }
+
+        private:
+            MappedTelemetryReader(MappedFile file,
+                                  std::uint16_t version,
+                                  std::uint16_t flags,
+                                  Options opt,
+                                  telemetry::Logger& logger);
+
+            MappedFile file_;
+            std::size_t offset_{0};
+            std::size_t data_end_{0};   // end of record data (index footer start or file size)
+            std::uint16_t version_{0};
+            std::uint16_t flags_{0};
+            Options opt_;
+            telemetry::Logger& logger_;
+
+            bool blocks_{false};
+            std::vector<std::uint8_t> block_;   // records of the current block
+            std::size_t block_pos_{0};          // next record within block_
+    };
+
+} // namespace telemetry
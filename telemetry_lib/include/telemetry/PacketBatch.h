@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace telemetry {
+
+    // Packets returned together by TelemetryReader::read_batch.
+    //
+    // Payloads are packed back to back in one arena; packet i is
+    // arena()[offsets()[i], offsets()[i] + lengths()[i]). The batch owns all of
+    // its memory, so a whole batch moves to a worker thread in one std::move.
+    // For fixed-size payloads (e.g. TelemetryFrames) the arena is a packed
+    // region that telemetry_sim::decode_frames(arena(), size, count, ...) decodes directly.
+    class PacketBatch {
+        public:
+            std::size_t size() const noexcept { return lengths_.size(); }
+            bool empty() const noexcept { return lengths_.empty(); }
+
+            std::span<const std::uint8_t> packet(std::size_t i) const noexcept {
+                return {arena_.data() + offsets_[i], lengths_[i]};
+            }
+
+            std::span<const std::uint8_t> arena() const noexcept { return arena_; }
+            std::span<const std::size_t> offsets() const noexcept { return offsets_; }
+            std::span<const std::uint32_t> lengths() const noexcept { return lengths_; }
+
+            // File offset of each record (of the block holding it, for
+            // block-compressed files)
+            std::span<const std::uint64_t> file_offsets() const noexcept { return file_offsets_; }
+
+            // Record number of packet(0)
+            std::uint64_t first_record() const noexcept { return first_record_; }
+
+            // Payload bytes in the arena
+            std::size_t payload_bytes() const noexcept { return arena_.size(); }
+
+            // Empties the batch but keeps its capacity for the next read_batch.
+            void clear(std::uint64_t first_record = 0) noexcept {
+                arena_.clear();
+                offsets_.clear();
+                lengths_.clear();
+                file_offsets_.clear();
+                first_record_ = first_record;
+            }
+
+            void append(std::span<const std::uint8_t> payload, std::uint64_t file_offset) {
+                offsets_.push_back(arena_.size());
+                lengths_.push_back(static_cast<std::uint32_t>(payload.size()));
+                file_offsets_.push_back(file_offset);
+                arena_.insert(arena_.end(), payload.begin(), payload.end());
+            }
+
+        private:
+            std::vector<std::uint8_t> arena_;
+            std::vector<std::size_t> offsets_;
+            std::vector<std::uint32_t> lengths_;
+            std::vector<std::uint64_t> file_offsets_;
+            std::uint64_t first_record_ = 0;
+    };
+
+} // namespace telemetry
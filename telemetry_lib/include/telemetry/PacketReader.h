@@ -1,19 +1,169 @@
 #pragma once
 
+#include <bit>
 #include <cstdint>
+#include <cstring>
 #include <span>
 #include <vector>
 #include <cstddef>
+#include <optional>
 #include <stdexcept>
 #include <string_view>
+#include <tuple>
+
+#include "telemetry/ByteOrder.h"
+#include "telemetry/Varint.h"
 
 namespace telemetry {
 
+    /// @brief Read cursor shared by PacketReader and BasicPacketReader<E>.
+    ///
+    /// Holds the unread part of the buffer and the byte-order-independent reads.
+    class PacketReaderBase {
+    public:
+        /// @brief Returns the number of bytes remaining to read.
+        [[nodiscard]] std::size_t remaining() const noexcept { return buffer_.size(); }
+
+        /// @brief Returns true if all bytes have been read.
+        [[nodiscard]] bool empty() const noexcept { return buffer_.empty(); }
+
+        /// @brief Reads an unsigned 8-bit value from the buffer.
+        std::uint8_t read_u8() { return load<std::uint8_t>(false); }
+
+        /// @brief Reads raw bytes into a destination buffer.
+        /// @param dst Span to fill.
+        void read_bytes(std::span<std::uint8_t> dst);
+
+        /// @brief Skips a number of bytes in the buffer.
+        /// @param count Number of bytes to skip.
+        void skip(std::size_t count);
+
+        /// @brief Reads a LEB128 variable-length integer (as written by add_varint).
+        /// Throws std::out_of_range if the buffer ends mid-value or the encoding
+        /// runs past 10 bytes; nothing is consumed in either case.
+        std::uint64_t read_varint();
+
+        /// @brief Reads a ZigZag + LEB128 signed integer (add_varint_signed).
+        std::int64_t read_varint_signed() { return zigzag_decode(read_varint()); }
+
+        /// @brief Non-throwing read_varint: std::nullopt (consuming nothing) on a
+        /// truncated or malformed value.
+        std::optional<std::uint64_t> try_read_varint() noexcept;
+
+        /// @brief Clears the buffer and resets reading position.
+        void clear() noexcept { buffer_ = {}; }
+
+    protected:
+        explicit PacketReaderBase(std::span<const std::uint8_t> buffer) noexcept
+            : buffer_(buffer) {}
+
+        ~PacketReaderBase() = default;
+
+        /// @brief One bounds check, one load and an (optional) byte swap.
+        /// Throws std::out_of_range without consuming anything if T does not fit.
+        template <PacketScalar T>
+        T load(bool swap) {
+            if (buffer_.size() < sizeof(T)) [[unlikely]] {
+                throw_exhausted();
+            }
+            const std::uint8_t* p = buffer_.data();
+            T value = decode_at<T>(p, swap);
+            buffer_ = buffer_.subspan(sizeof(T));
+            return value;
+        }
+
+        /// @brief Fixed layout Ts... with one bounds check for the whole group.
+        template <PacketScalar... Ts>
+        std::tuple<Ts...> load_struct(bool swap) {
+            if (buffer_.size() < (sizeof(Ts) + ... + 0)) [[unlikely]] {
+                throw_exhausted();
+            }
+            return load_struct_unchecked<Ts...>(swap);
+        }
+
+        template <PacketScalar... Ts>
+        std::optional<std::tuple<Ts...>> try_load_struct(bool swap) noexcept {
+            if (buffer_.size() < (sizeof(Ts) + ... + 0)) {
+                return std::nullopt;
+            }
+            return load_struct_unchecked<Ts...>(swap);
+        }
+
+        /// @brief Fills out with out.size() values of T after one bounds check.
+        template <PacketScalar T>
+        bool try_load_array(std::span<T> out, bool swap) noexcept {
+            if (out.size() > buffer_.size() / sizeof(T)) {
+                return false;
+            }
+            const std::uint8_t* src = buffer_.data();
+            if (!swap || sizeof(T) == 1) {
+                std::memcpy(out.data(), src, out.size_bytes());
+            } else {
+                for (T& value : out) {
+                    value = decode_at<T>(src, true);
+                }
+            }
+            buffer_ = buffer_.subspan(out.size_bytes());
+            return true;
+        }
+
+        template <PacketScalar T>
+        void load_array(std::span<T> out, bool swap) {
+            if (!try_load_array(out, swap)) [[unlikely]] {
+                throw_exhausted();
+            }
+        }
+
+        template <PacketScalar T>
+        std::vector<T> load_vector(std::size_t n, bool swap) {
+            if (n > buffer_.size() / sizeof(T)) [[unlikely]] {
+                throw_exhausted();
+            }
+            std::vector<T> out(n);
+            try_load_array(std::span<T>(out), swap);
+            return out;
+        }
+
+        template <PacketScalar T>
+        std::optional<T> try_load(bool swap) noexcept {
+            if (buffer_.size() < sizeof(T)) {
+                return std::nullopt;
+            }
+            const std::uint8_t* p = buffer_.data();
+            T value = decode_at<T>(p, swap);
+            buffer_ = buffer_.subspan(sizeof(T));
+            return value;
+        }
+
+    private:
+        std::span<const std::uint8_t> buffer_;
+
+        [[noreturn]] static void throw_exhausted();
+
+        // Decodes a T at p and advances p; the caller has checked the bounds.
+        template <PacketScalar T>
+        static T decode_at(const std::uint8_t*& p, bool swap) noexcept {
+            scalar_bits_t<T> bits;
+            std::memcpy(&bits, p, sizeof(bits));
+            p += sizeof(bits);
+            return bits_to_scalar<T>(bits, swap);
+        }
+
+        template <PacketScalar... Ts>
+        std::tuple<Ts...> load_struct_unchecked(bool swap) noexcept {
+            const std::uint8_t* p = buffer_.data();
+            // Braced initialization evaluates left to right, i.e. in field order
+            std::tuple<Ts...> out{decode_at<Ts>(p, swap)...};
+            buffer_ = buffer_.subspan((sizeof(Ts) + ... + 0));
+            return out;
+        }
+    };
+
     /// @brief Utility class to read primitive types from a serialized packet buffer.
-    /// 
+    ///
     /// Reads data in the same order as PacketWriter writes them. Supports
-    /// little- and big-endian formats.
-    class PacketReader {
+    /// little- and big-endian formats, chosen at run time.
+    class PacketReader : public PacketReaderBase {
     public:
         enum class Endianness {
             Little,
@@ -25,17 +175,8 @@ namespace telemetry {
         /// @param endianness Endianness of the serialized data (default Big to match PacketWriter).
         explicit PacketReader(std::span<const std::uint8_t> buffer,
                               Endianness endianness = Endianness::Big) noexcept;
-        
-        ~PacketReader() = default;
 
-        /// @brief Returns the number of bytes remaining to read.
-        [[nodiscard]] std::size_t remaining() const noexcept;
-
-        /// @brief Returns true if all bytes have been read.
-        [[nodiscard]] bool empty() const noexcept;
-
-        /// @brief Reads an unsigned 8-bit value from the buffer.
-        std::uint8_t read_u8();
+        ~PacketReader() = default;
 
         /// @brief Reads an unsigned 16-bit value from the buffer.
         std::uint16_t read_u16();
@@ -49,20 +190,85 @@ namespace telemetry {
         /// @brief Reads a single-precision float from the buffer.
         float read_float();
 
-        /// @brief Reads raw bytes into a destination buffer.
-        /// @param dst Span to fill.
-        void read_bytes(std::span<std::uint8_t> dst);
+        /// @brief Reads any fixed-width integer or float.
+        template <PacketScalar T>
+        T read() { return load<T>(swap_); }
 
-        /// @brief Skips a number of bytes in the buffer.
-        /// @param count Number of bytes to skip.
-        void skip(std::size_t count);
+        /// @brief Reads consecutive fields Ts... with a single bounds check.
+        ///
+        ///     auto [ts, temp, flags] = reader.read_struct<std::uint64_t, float, std::uint32_t>();
+        template <PacketScalar... Ts>
+        std::tuple<Ts...> read_struct() { return load_struct<Ts...>(swap_); }
 
-        /// @brief Clears the buffer and resets reading position.
-        void clear() noexcept;
+        /// @brief Reads n values of T (no length prefix) with a single bounds check.
+        template <PacketScalar T>
+        std::vector<T> read_array(std::size_t n) { return load_vector<T>(n, swap_); }
+
+        /// @brief Fills dst with dst.size() values of T.
+        template <PacketScalar T>
+        void read_array(std::span<T> dst) { load_array(dst, swap_); }
+
+        /// @name Non-throwing reads
+        /// Return std::nullopt / false (consuming nothing) when the buffer is too
+        /// short, so corrupt packets can be skipped without exception unwinding.
+        /// @{
+        template <PacketScalar T>
+        std::optional<T> try_read() noexcept { return try_load<T>(swap_); }
+
+        template <PacketScalar... Ts>
+        std::optional<std::tuple<Ts...>> try_read_struct() noexcept { return try_load_struct<Ts...>(swap_); }
+
+        template <PacketScalar T>
+        bool try_read_array(std::span<T> dst) noexcept { return try_load_array(dst, swap_); }
+        /// @}
 
     private:
-        std::span<const std::uint8_t> buffer_;
-        Endianness endianness_;
+        bool swap_;                  ///< Packet byte order differs from the host
     };
 
+    /// @brief PacketReader with the byte order fixed at compile time.
+    ///
+    /// The swap folds away (no-op when E matches the host), so each read is a
+    /// bounds check and a single load, and decode loops can be inlined whole.
+    template <std::endian E>
+    class BasicPacketReader : public PacketReaderBase {
+    public:
+        static constexpr std::endian byte_order = E;
+
+        explicit BasicPacketReader(std::span<const std::uint8_t> buffer) noexcept
+            : PacketReaderBase(buffer) {}
+
+        std::uint16_t read_u16() { return load<std::uint16_t>(kSwap); }
+        std::uint32_t read_u32() { return load<std::uint32_t>(kSwap); }
+        std::uint64_t read_u64() { return load<std::uint64_t>(kSwap); }
+        float read_float() { return load<float>(kSwap); }
+
+        template <PacketScalar T>
+        T read() { return load<T>(kSwap); }
+
+        template <PacketScalar... Ts>
+        std::tuple<Ts...> read_struct() { return load_struct<Ts...>(kSwap); }
+
+        template <PacketScalar T>
+        std::vector<T> read_array(std::size_t n) { return load_vector<T>(n, kSwap); }
+
+        template <PacketScalar T>
+        void read_array(std::span<T> dst) { load_array(dst, kSwap); }
+
+        template <PacketScalar T>
+        std::optional<T> try_read() noexcept { return try_load<T>(kSwap); }
+
+        template <PacketScalar... Ts>
+        std::optional<std::tuple<Ts...>> try_read_struct() noexcept { return try_load_struct<Ts...>(kSwap); }
+
+        template <PacketScalar T>
+        bool try_read_array(std::span<T> dst) noexcept { return try_load_array(dst, kSwap); }
+
+    private:
+        static constexpr bool kSwap = (E != std::endian::native);
+    };
+
+    using BigEndianPacketReader = BasicPacketReader<std::endian::big>;
+    using LittleEndianPacketReader = BasicPacketReader<std::endian::little>;
+
 } // namespace telemetry
@@ -1,14 +1,146 @@
 #pragma once
 
 #include <vector>
+#include <array>
+#include <bit>
 #include <cstdint>
+#include <cstring>
 #include <span>
 #include <cstddef>
 #include <string_view>
+#include <utility>
+
+#include "telemetry/ByteOrder.h"
+#include "telemetry/Varint.h"
 
 namespace telemetry {
 
-    class PacketWriter {
+    class PacketWriterBase;
+
+    // Bump allocator over a caller-owned block. Packets serialized with
+    // PacketWriter(arena) are laid out back to back and stay valid until reset().
+    class PacketArena {
+        public:
+            explicit PacketArena(std::span<std::uint8_t> storage) noexcept
+                : storage_(storage) {}
+
+            // Returns n bytes, or an empty span if they do not fit.
+            std::span<std::uint8_t> allocate(std::size_t n) noexcept;
+
+            // Releases every allocation (and every packet written into the arena).
+            void reset() noexcept { used_ = 0; }
+
+            std::size_t used() const noexcept { return used_; }
+            std::size_t capacity() const noexcept { return storage_.size(); }
+            std::size_t remaining() const noexcept { return storage_.size() - used_; }
+
+        private:
+            friend class PacketWriterBase;
+
+            std::span<std::uint8_t> storage_;
+            std::size_t used_ = 0;
+    };
+
+    // Inline storage for a fixed-capacity writer (stack or member, no heap).
+    template <std::size_t N>
+    struct FixedBuffer {
+        alignas(8) std::array<std::uint8_t, N> storage{};
+
+        std::span<std::uint8_t> span() noexcept { return storage; }
+    };
+
+    // Storage shared by PacketWriter and BasicPacketWriter<E>: an owned growable
+    // buffer, caller-owned span or arena tail, plus the byte-order-independent API.
+    class PacketWriterBase {
+        public:
+            std::span<const std::uint8_t> bytes() const;
+            void clear();
+            std::size_t size() const;
+
+            // Owning writers only; caller-owned storage cannot grow.
+            void reserve(std::size_t);
+
+            // True if a write did not fit the caller-owned storage (sticky until clear()).
+            // bytes() then holds only the writes that fit and should not be sent.
+            bool overflowed() const noexcept { return overflowed_; }
+            std::size_t capacity() const noexcept { return capacity_; }
+
+        protected:
+            // Owns a growable heap buffer.
+            PacketWriterBase() noexcept = default;
+
+            // Writes into caller-owned storage and never allocates. A write that does
+            // not fit is skipped and sets overflowed(); nothing throws.
+            explicit PacketWriterBase(std::span<std::uint8_t> storage) noexcept;
+
+            // Writes at the arena's tail, bumping it as bytes are added. One writer
+            // at a time: once anything else allocates from the arena, further
+            // writes overflow instead of overlapping.
+            explicit PacketWriterBase(PacketArena& arena) noexcept;
+
+            ~PacketWriterBase();
+
+            // Non-copyable (a copy would alias the same storage); movable.
+            PacketWriterBase(const PacketWriterBase&) = delete;
+            PacketWriterBase& operator=(const PacketWriterBase&) = delete;
+            PacketWriterBase(PacketWriterBase&& other) noexcept;
+            PacketWriterBase& operator=(PacketWriterBase&& other) noexcept;
+
+            // One (optional) byte swap + one store.
+            template <PacketScalar T>
+            void put(T value, bool swap) {
+                auto bits = scalar_to_bits(value, swap);
+                if (std::uint8_t* out = grow(sizeof(bits))) {
+                    std::memcpy(out, &bits, sizeof(bits));
+                }
+            }
+
+            // Consecutive fields with a single capacity check.
+            template <PacketScalar... Ts>
+            void put_struct(bool swap, Ts... values) {
+                if (std::uint8_t* out = grow((sizeof(Ts) + ... + 0))) {
+                    (store(out, values, swap), ...);
+                }
+            }
+
+            template <PacketScalar T>
+            void put_many(std::span<const T> values, bool swap);
+
+            void put_bytes(std::span<const std::uint8_t> bytes);
+
+            // u16 length prefix + bytes; throws std::length_error above 65535 bytes.
+            void put_string(std::string_view s, bool swap);
+
+            // LEB128 (1-10 bytes, see Varint.h); byte order does not apply.
+            void put_varint(std::uint64_t value);
+
+        private:
+            // Owning mode: buffer_.size() is the capacity in use.
+            std::vector<std::uint8_t> buffer_;
+            std::uint8_t* data_ = nullptr;     // buffer_ or caller-owned storage
+            std::size_t capacity_ = 0;
+            std::size_t size_ = 0;
+            bool owning_ = true;
+            bool overflowed_ = false;
+
+            // Arena mode: where this packet starts inside the arena
+            PacketArena* arena_ = nullptr;
+            std::size_t arena_offset_ = 0;
+
+            template <PacketScalar T>
+            static void store(std::uint8_t*& out, T value, bool swap) noexcept {
+                auto bits = scalar_to_bits(value, swap);
+                std::memcpy(out, &bits, sizeof(bits));
+                out += sizeof(bits);
+            }
+
+            // Makes room for n more bytes and returns where they go,
+            // or nullptr (and overflowed_) if caller-owned storage is full.
+            std::uint8_t* grow(std::size_t n);
+    };
+
+    // Writer whose byte order is chosen at run time (one predictable branch per field).
+    class PacketWriter : public PacketWriterBase {
         public:
             enum class Endianness {
                 Little,
@@ -16,8 +148,16 @@ namespace telemetry {
             };
 
             explicit PacketWriter(Endianness endianness = Endianness::Big);
+            explicit PacketWriter(std::span<std::uint8_t> storage,
+                                  Endianness endianness = Endianness::Big) noexcept;
+            explicit PacketWriter(PacketArena& arena,
+                                  Endianness endianness = Endianness::Big) noexcept;
             ~PacketWriter();
 
+            PacketWriter(PacketWriter&&) noexcept = default;
+            PacketWriter& operator=(PacketWriter&&) noexcept = default;
+
+            // Each fixed-width value is one (optional) byte swap + one store.
             PacketWriter& add_u8(std::uint8_t);
             PacketWriter& add_u16(std::uint16_t);
             PacketWriter& add_u32(std::uint32_t);
@@ -26,12 +166,109 @@ namespace telemetry {
             PacketWriter& add_string(std::string_view);
             PacketWriter& add_float(float);
 
-            std::span<const std::uint8_t> bytes() const;
-            void clear();
-            std::size_t size() const;
-            void reserve(std::size_t);
+            // Variable-length integers: LEB128, and ZigZag + LEB128 for signed values
+            // (small deltas take one byte). Not affected by the byte order.
+            PacketWriter& add_varint(std::uint64_t);
+            PacketWriter& add_varint_signed(std::int64_t);
+
+            // Bulk encode of an array of integers / floats (no length prefix).
+            // Equivalent to calling the matching add_* for each element; when the
+            // packet's byte order matches the host the whole span is one memcpy.
+            template <PacketScalar T>
+            PacketWriter& add_many(std::span<const T> values) {
+                put_many(values, swap_);
+                return *this;
+            }
+
+            // Fixed layout in one go: one capacity check, then one store per value.
+            //   pw.add_struct(ts, temperature, flags);
+            template <PacketScalar... Ts>
+            PacketWriter& add_struct(Ts... values) {
+                put_struct(swap_, values...);
+                return *this;
+            }
+
         private:
-            std::vector<std::uint8_t> buffer_;
-            Endianness endianness_;            
+            bool swap_;                        // packet byte order differs from the host
     };
-} // namespace telemetry
\ No newline at end of file
+
+    // Writer whose byte order is fixed at compile time: the swap folds away
+    // (no-op when E matches the host), so encode loops are straight-line stores.
+    template <std::endian E>
+    class BasicPacketWriter : public PacketWriterBase {
+        public:
+            static constexpr std::endian byte_order = E;
+
+            BasicPacketWriter() noexcept = default;
+            explicit BasicPacketWriter(std::span<std::uint8_t> storage) noexcept
+                : PacketWriterBase(storage) {}
+            explicit BasicPacketWriter(PacketArena& arena) noexcept
+                : PacketWriterBase(arena) {}
+
+            BasicPacketWriter(BasicPacketWriter&&) noexcept = default;
+            BasicPacketWriter& operator=(BasicPacketWriter&&) noexcept = default;
+
+            BasicPacketWriter& add_u8(std::uint8_t value) { put(value, kSwap); return *this; }
+            BasicPacketWriter& add_u16(std::uint16_t value) { put(value, kSwap); return *this; }
+            BasicPacketWriter& add_u32(std::uint32_t value) { put(value, kSwap); return *this; }
+            BasicPacketWriter& add_u64(std::uint64_t value) { put(value, kSwap); return *this; }
+            BasicPacketWriter& add_float(float value) { put(value, kSwap); return *this; }
+            BasicPacketWriter& add_bytes(std::span<const std::uint8_t> bytes) { put_bytes(bytes); return *this; }
+            BasicPacketWriter& add_string(std::string_view s) { put_string(s, kSwap); return *this; }
+            BasicPacketWriter& add_varint(std::uint64_t value) { put_varint(value); return *this; }
+            BasicPacketWriter& add_varint_signed(std::int64_t value) { put_varint(zigzag_encode(value)); return *this; }
+
+            template <PacketScalar T>
+            BasicPacketWriter& add_many(std::span<const T> values) {
+                put_many(values, kSwap);
+                return *this;
+            }
+
+            template <PacketScalar... Ts>
+            BasicPacketWriter& add_struct(Ts... values) {
+                put_struct(kSwap, values...);
+                return *this;
+            }
+
+        private:
+            static constexpr bool kSwap = (E != std::endian::native);
+    };
+
+    using BigEndianPacketWriter = BasicPacketWriter<std::endian::big>;
+    using LittleEndianPacketWriter = BasicPacketWriter<std::endian::little>;
+
+    // Writer over inline FixedBuffer<N> storage: zero allocations.
+    // Constructor arguments after the storage are forwarded (e.g. the Endianness).
+    //
+    //   FixedPacketWriter<64> pw;
+    //   frame.serialize(pw);
+    //   if (!pw.overflowed()) recorder.write_packet(pw.bytes());
+    template <std::size_t N, class Writer = PacketWriter>
+    class FixedPacketWriter : private FixedBuffer<N>, public Writer {
+        public:
+            template <class... Args>
+            explicit FixedPacketWriter(Args&&... args) noexcept
+                : FixedBuffer<N>(),
+                  Writer(FixedBuffer<N>::span(), std::forward<Args>(args)...) {}
+
+            // The writer points into this object, so it cannot be moved
+            FixedPacketWriter(FixedPacketWriter&&) = delete;
+            FixedPacketWriter& operator=(FixedPacketWriter&&) = delete;
+    };
+
+    template <PacketScalar T>
+    void PacketWriterBase::put_many(std::span<const T> values, bool swap) {
+        std::uint8_t* out = grow(values.size_bytes());
+        if (out == nullptr || values.empty()) {
+            return;
+        }
+        if (!swap || sizeof(T) == 1) {
+            std::memcpy(out, values.data(), values.size_bytes());
+            return;
+        }
+        for (T value : values) {
+            store(out, value, true);
+        }
+    }
+
+} // namespace telemetry
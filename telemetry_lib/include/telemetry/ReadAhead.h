@@ -0,0 +1,79 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace telemetry {
+
+    // Sequential chunk producer behind TelemetryReader's read-ahead: a thread
+    // (ReadAhead) or queued io_uring reads (UringReadAhead, IoUring.h).
+    class ChunkSource {
+        public:
+            virtual ~ChunkSource() = default;
+
+            // (Re)starts reading at offset; chunks queued for the old position are dropped.
+            virtual void start(std::uint64_t offset) = 0;
+
+            // Next chunk in file order, or an empty span at the end. The chunk stays
+            // valid until the next call to next() or start().
+            // Throws std::runtime_error if a read failed.
+            virtual std::span<const std::uint8_t> next() = 0;
+    };
+
+    // Background sequential reader: one thread pread()s consecutive chunks of a
+    // file into a bounded ring of buffers ahead of the consumer, so the consumer
+    // only waits when it is faster than the device. The file is opened with
+    // posix_fadvise(POSIX_FADV_SEQUENTIAL) for aggressive kernel read-ahead.
+    //
+    // With `buffers` slots the consumer holds one chunk while up to buffers - 1
+    // are read ahead (3 = triple buffering).
+    class ReadAhead : public ChunkSource {
+        public:
+            // Opens the file; reads never go past `end` (e.g. an index footer).
+            // Throws std::runtime_error if the file cannot be opened.
+            ReadAhead(const std::filesystem::path& path,
+                      std::uint64_t end,
+                      std::size_t chunk_bytes,
+                      std::size_t buffers = 3);
+
+            ReadAhead(const ReadAhead&) = delete;
+            ReadAhead& operator=(const ReadAhead&) = delete;
+
+            // Stops the thread and closes the file.
+            ~ReadAhead() override;
+
+            void start(std::uint64_t offset) override;
+            std::span<const std::uint8_t> next() override;
+
+        private:
+            void run();
+
+            int fd_ = -1;
+            std::uint64_t end_ = 0;
+            std::size_t chunk_bytes_ = 0;
+
+            // ---- Ring state (guarded by mutex_) ----
+            std::vector<std::vector<std::uint8_t>> buffers_;
+            std::vector<std::size_t> sizes_;
+            std::size_t head_ = 0;           // oldest filled slot
+            std::size_t count_ = 0;          // filled slots waiting for the consumer
+            bool holding_ = false;           // the consumer holds the slot before head_
+            std::uint64_t read_offset_ = 0;  // next offset the thread reads
+            std::uint64_t generation_ = 0;   // bumped by start(); stale reads are dropped
+            bool done_ = false;              // reached end_ / EOF
+            bool stop_ = false;
+            std::string error_;
+
+            std::mutex mutex_;
+            std::condition_variable cv_;
+            std::thread thread_;
+    };
+
+} // namespace telemetry
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "telemetry/TelemetryReader.h" // ParseError
+
+namespace telemetry {
+
+    // In-memory framing of the TLRY format, shared by readers that work on
+    // buffers instead of streams. Every ParseError carries the same message
+    // TelemetryReader::open()/read_next() would throw for the same bytes.
+
+    struct FileHeader {
+        std::uint16_t version = 0;
+        std::uint16_t flags = 0;
+    };
+
+    // One framed record located inside a byte range.
+    struct RecordView {
+        std::span<const std::uint8_t> payload;  // points into the source bytes
+        std::uint32_t stored_crc = 0;
+        std::size_t record_bytes = 0;           // size field + payload + CRC
+    };
+
+    // Validates magic + version and returns the header fields.
+    FileHeader parse_header(std::span<const std::uint8_t> bytes);
+
+    // Frames the record at the start of bytes without checking its CRC.
+    // Returns false at a clean end (bytes is empty).
+    bool frame_record(std::span<const std::uint8_t> bytes,
+                      std::size_t max_packet_size,
+                      RecordView& out);
+
+    // Throws the ParseError read_next() reports when a record whose size field
+    // holds `size` does not fit in the `available` bytes after that field.
+    void require_record_bytes(std::uint32_t size, std::size_t available);
+
+    // True if the stored CRC matches the payload.
+    bool record_crc_ok(const RecordView& record);
+
+    // ---- Compressed blocks (format::kFlagBlockCompressed) ----
+
+    struct BlockView {
+        std::span<const std::uint8_t> stored;   // compressed (or stored) bytes
+        std::uint32_t raw_size = 0;
+        std::uint32_t stored_crc = 0;
+        std::size_t block_bytes = 0;            // header + stored bytes
+    };
+
+    // Largest raw block accepted for a given max_packet_size.
+    std::size_t max_block_raw_size(std::size_t max_packet_size) noexcept;
+
+    // Validates a block header (format::kBlockHeaderSize bytes) and returns its
+    // stored size; out.stored is left for the caller to point at those bytes.
+    std::uint32_t parse_block_header(std::span<const std::uint8_t> header,
+                                     std::size_t max_packet_size,
+                                     BlockView& out);
+
+    // Frames the block at the start of bytes without checking its CRC.
+    // Returns false at a clean end (bytes is empty).
+    bool frame_block(std::span<const std::uint8_t> bytes,
+                     std::size_t max_packet_size,
+                     BlockView& out);
+
+    // Checks the block CRC and restores its records into out (resized to raw_size).
+    // Throws ParseError("incorrect block CRC") / ParseError("corrupt compressed block"),
+    // leaving out empty.
+    void decode_block(const BlockView& block, std::vector<std::uint8_t>& out);
+
+    // Appends header + block for the records in raw, compressed if that is smaller.
+    // scratch is reused between calls. Returns the bytes appended.
+    std::size_t append_block(std::vector<std::uint8_t>& out,
+                             std::span<const std::uint8_t> raw,
+                             std::vector<std::uint8_t>& scratch);
+
+    // ---- Sparse record index footer (format::kFlagIndexed) ----
+
+    struct IndexEntry {
+        std::uint64_t record_offset = 0;   // file offset of the record's size field
+        std::uint64_t timestamp_ms = 0;
+    };
+
+    struct IndexTrailer {
+        std::uint64_t record_count = 0;
+        std::uint32_t entry_count = 0;
+        std::uint32_t interval = 0;
+        std::uint32_t footer_crc = 0;      // entries + record_count/entry_count/interval
+
+        // Bytes occupied by entries + trailer at the end of the file.
+        std::size_t footer_bytes() const noexcept;
+    };
+
+    // Parses the fixed trailer (the last format::kIndexTrailerSize bytes of a file).
+    // Returns false if the bytes are not a valid trailer, or if entry_count is not
+    // ceil(record_count / interval).
+    bool parse_index_trailer(std::span<const std::uint8_t> bytes, IndexTrailer& out);
+
+    // Decodes the entry block that starts the footer at footer_start and checks the
+    // footer CRC. Returns false on a size or CRC mismatch, or if an entry's offset
+    // is outside [kHeaderSize, footer_start) or offsets/timestamps go backwards.
+    bool parse_index_entries(std::span<const std::uint8_t> bytes,
+                             const IndexTrailer& trailer,
+                             std::uint64_t footer_start,
+                             std::vector<IndexEntry>& out);
+
+    // Appends entries + trailer to out.
+    void append_index_footer(std::vector<std::uint8_t>& out,
+                             std::span<const IndexEntry> entries,
+                             std::uint64_t record_count,
+                             std::uint32_t interval);
+
+    // Locates and decodes the footer of an in-memory file.
+    // Returns the offset where record data ends (the footer start), or
+    // file.size() if the file has no valid footer (entries is left empty).
+    std::size_t load_index_footer(std::span<const std::uint8_t> file,
+                                  IndexTrailer& trailer,
+                                  std::vector<IndexEntry>& entries);
+
+} // namespace telemetry
@@ -0,0 +1,214 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "telemetry/ByteOrder.h"
+
+namespace telemetry {
+
+    // Compile-time wire layout for fixed-size packet structs.
+    //
+    // A struct lists its fields once, in wire order:
+    //
+    //   struct Sample {
+    //       std::uint64_t ts = 0;
+    //       float value = 0.0f;
+    //
+    //       static constexpr auto schema() {
+    //           return telemetry::make_schema(telemetry::field("ts", &Sample::ts),
+    //                                         telemetry::field("value", &Sample::value));
+    //       }
+    //   };
+    //
+    // and gets encode/decode (one capacity / bounds check per struct), its wire size
+    // and field offsets as constants, CSV output, column extraction and projection.
+
+    // One wire field: its name (CSV header, diagnostics) and the member it maps to.
+    template <class Struct, PacketScalar T>
+    struct FieldDescriptor {
+        using struct_type = Struct;
+        using value_type = T;
+
+        std::string_view name;
+        T Struct::* member;
+    };
+
+    template <class Struct, PacketScalar T>
+    constexpr FieldDescriptor<Struct, T> field(std::string_view name, T Struct::* member) noexcept {
+        return {name, member};
+    }
+
+    // Ordered fields of Struct. The wire layout is the fields back to back, no padding.
+    template <class Struct, class... Fields>
+    struct Schema {
+        std::tuple<Fields...> fields;
+
+        static constexpr std::size_t field_count = sizeof...(Fields);
+        static constexpr std::size_t wire_size = (sizeof(typename Fields::value_type) + ... + 0);
+
+        // Byte offset of each field inside an encoded packet
+        static constexpr std::array<std::size_t, field_count> offsets = [] {
+            std::array<std::size_t, field_count> out{};
+            std::size_t at = 0;
+            std::size_t i = 0;
+            ((out[i++] = at, at += sizeof(typename Fields::value_type)), ...);
+            return out;
+        }();
+
+        template <std::size_t I>
+        using field_type = std::tuple_element_t<I, std::tuple<typename Fields::value_type...>>;
+    };
+
+    template <class Struct, class... Ts>
+    constexpr Schema<Struct, FieldDescriptor<Struct, Ts>...> make_schema(FieldDescriptor<Struct, Ts>... fields) noexcept {
+        return {{fields...}};
+    }
+
+    // A struct that describes its wire layout with `static constexpr auto schema()`.
+    template <class S>
+    concept Described = requires { S::schema().fields; };
+
+    template <Described S>
+    using schema_of_t = decltype(S::schema());
+
+    template <Described S>
+    inline constexpr std::size_t wire_size_v = schema_of_t<S>::wire_size;
+
+    template <Described S>
+    inline constexpr auto field_offsets_v = schema_of_t<S>::offsets;
+
+    template <Described S, std::size_t I>
+    using field_type_t = typename schema_of_t<S>::template field_type<I>;
+
+    template <Described S, std::size_t I>
+    constexpr std::string_view field_name() noexcept {
+        return std::get<I>(S::schema().fields).name;
+    }
+
+    // ---- Codecs (any PacketWriter / PacketReader flavour) ----
+
+    namespace detail {
+        // Calls fn(std::integral_constant<size_t, I>...) for every field index, so the
+        // callee can use std::get<I> on a constexpr schema (member pointers stay constants).
+        template <Described S, class Fn>
+        constexpr decltype(auto) with_field_indices(Fn&& fn) {
+            return [&]<std::size_t... I>(std::index_sequence<I...>) -> decltype(auto) {
+                return fn(std::integral_constant<std::size_t, I>{}...);
+            }(std::make_index_sequence<schema_of_t<S>::field_count>{});
+        }
+
+        template <Described S, std::size_t I>
+        inline constexpr auto member_v = std::get<I>(S::schema().fields).member;
+    }
+
+    // Appends value's fields in schema order: one capacity check, one store per field.
+    template <Described S, class Writer>
+    void encode(const S& value, Writer& writer) {
+        detail::with_field_indices<S>([&](auto... i) {
+            writer.add_struct(value.*detail::member_v<S, decltype(i)::value>...);
+        });
+    }
+
+    // Reads every field with a single bounds check; throws std::out_of_range if short.
+    template <Described S, class Reader>
+    void decode(S& value, Reader& reader) {
+        detail::with_field_indices<S>([&](auto... i) {
+            std::tie(value.*detail::member_v<S, decltype(i)::value>...) =
+                reader.template read_struct<field_type_t<S, decltype(i)::value>...>();
+        });
+    }
+
+    // Non-throwing decode; on a short packet returns false and leaves value untouched.
+    template <Described S, class Reader>
+    bool try_decode(S& value, Reader& reader) noexcept {
+        return detail::with_field_indices<S>([&](auto... i) {
+            auto fields = reader.template try_read_struct<field_type_t<S, decltype(i)::value>...>();
+            if (fields) {
+                std::tie(value.*detail::member_v<S, decltype(i)::value>...) = *fields;
+            }
+            return fields.has_value();
+        });
+    }
+
+    // ---- Projection: selected fields straight from an encoded packet ----
+
+    // Decodes only fields I... (by schema index) at their constant offsets, without
+    // touching the others. Returns std::nullopt if the packet is shorter than wire_size_v<S>.
+    //
+    //   auto v = decode_fields<Frame, std::endian::big, 0, 5>(packet);   // timestamp + velocity
+    template <Described S, std::endian E, std::size_t... I>
+    std::optional<std::tuple<field_type_t<S, I>...>> decode_fields(std::span<const std::uint8_t> packet) noexcept {
+        if (packet.size() < wire_size_v<S>) {
+            return std::nullopt;
+        }
+        auto load = [&]<std::size_t Index>(std::integral_constant<std::size_t, Index>) {
+            using T = field_type_t<S, Index>;
+            scalar_bits_t<T> bits;
+            std::memcpy(&bits, packet.data() + field_offsets_v<S>[Index], sizeof(bits));
+            return bits_to_scalar<T>(bits, E != std::endian::native);
+        };
+        return std::tuple<field_type_t<S, I>...>{load(std::integral_constant<std::size_t, I>{})...};
+    }
+
+    // ---- Columns and CSV ----
+
+    // Field I of every row, as one contiguous column.
+    template <std::size_t I, Described S>
+    std::vector<field_type_t<S, I>> extract_column(std::span<const S> rows) {
+        std::vector<field_type_t<S, I>> column;
+        column.reserve(rows.size());
+        for (const S& row : rows) {
+            column.push_back(row.*detail::member_v<S, I>);
+        }
+        return column;
+    }
+
+    // Calls fn(name, value) for each field in schema order.
+    template <Described S, class Fn>
+    void for_each_field(const S& value, Fn&& fn) {
+        std::apply([&](const auto&... f) { (fn(f.name, value.*(f.member)), ...); }, S::schema().fields);
+    }
+
+    // Comma-separated field names, e.g. "timestamp_ms,temperature_c,..."
+    template <Described S>
+    std::string csv_header() {
+        std::string header;
+        std::apply([&](const auto&... f) {
+            ((header += header.empty() ? "" : ",", header += f.name), ...);
+        }, S::schema().fields);
+        return header;
+    }
+
+    // One CSV line (with trailing newline) in the same column order as csv_header<S>()
+    template <Described S>
+    void write_csv_row(std::ostream& out, const S& value) {
+        bool first = true;
+        for_each_field(value, [&](std::string_view, const auto& field_value) {
+            if (!first) {
+                out << ',';
+            }
+            first = false;
+            // Unary + prints 8-bit integers as numbers, not characters
+            if constexpr (std::is_integral_v<std::remove_cvref_t<decltype(field_value)>>) {
+                out << +field_value;
+            } else {
+                out << field_value;
+            }
+        });
+        out << '\n';
+    }
+
+} // namespace telemetry
@@ -27,4 +27,54 @@ static_assert(kRecordSizeFieldBytes == 4,
 
 constexpr size_t CRC32_SIZE = 4; // bytes
 
+// ---- Header flags ----
+
+// The file ends with a sparse record index footer (see below).
+inline constexpr std::uint16_t kFlagIndexed = 0x0001;
+
+// Payloads are TelemetryFrames in the compact delta/varint encoding
+// (telemetry_sim::CompactFrameEncoder) rather than the fixed 32-byte layout.
+// Records stay self-delimiting; only the payload bytes change.
+inline constexpr std::uint16_t kFlagCompactFrames = 0x0002;
+
+// Records are grouped into compressed blocks (see below) instead of following
+// the header back to back.
+inline constexpr std::uint16_t kFlagBlockCompressed = 0x0004;
+
+// Flags that describe how payloads are encoded. They are chosen by the writer
+// (TelemetryRecorder::Options::payload_flags) and must match when appending.
+inline constexpr std::uint16_t kPayloadFlagsMask = kFlagCompactFrames;
+
+// ---- Index footer (kFlagIndexed) ----
+// Written when the recorder closes, directly after the last record:
+//
+//   entries:  [u64 record_offset][u64 timestamp_ms]   x entry_count
+//   trailer:  [u64 record_count][u32 entry_count][u32 interval][u32 crc][4 bytes "TIDX"]
+//
+// Entry k describes record k * interval, so entry_count == ceil(record_count / interval).
+// crc covers the entries and the trailer's record_count, entry_count and interval.
+// All integers are little endian.
+// A flagged file without a valid trailer (e.g. the recorder crashed) is read
+// as an unindexed file.
+inline constexpr std::array<std::uint8_t, 4> kIndexMagic{'T','I','D','X'};
+inline constexpr std::size_t kIndexEntrySize = 16;
+inline constexpr std::size_t kIndexTrailerSize = 24;
+
+// ---- Compressed blocks (kFlagBlockCompressed) ----
+// Record data is a sequence of blocks:
+//
+//   [u32 stored_size][u32 raw_size][u32 crc][stored bytes]
+//
+// The raw bytes are whole records in the usual framing ([u32 size][payload][u32 crc]
+// ...), LZ-compressed (telemetry/Lz.h) unless stored_size == raw_size, in which case
+// they are stored as-is because compression did not help. crc covers the stored
+// bytes. With kFlagIndexed, an index entry holds the offset of the block that starts
+// with the indexed record. Integers are little endian.
+inline constexpr std::size_t kBlockHeaderSize = 12;
+inline constexpr std::size_t kDefaultBlockBytes = 64 * 1024;
+
+// Largest raw block readers accept (a single bigger record still gets its own block,
+// within max_packet_size).
+inline constexpr std::size_t kMaxBlockBytes = 16 * 1024 * 1024;
+
 } // namespace telemetry::format
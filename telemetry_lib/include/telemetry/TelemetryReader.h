@@ -3,14 +3,19 @@
 #include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 #include <span>
 #include <stdexcept>
 #include <vector>
 
 #include "telemetry/Logger.h"
+#include "telemetry/PacketBatch.h"
+#include "telemetry/ReadAhead.h"
 
 namespace telemetry {
 
+    struct RecordView;
+
     // Format/parse errors (bad magic, truncated file, bad sizes, etc.)
     class ParseError : public std::runtime_error {
     public:
@@ -21,6 +26,23 @@ namespace telemetry {
         public:
             struct Options {
                 std::size_t max_packet_size = 64 * 1024; // defensive cap (64 KiB)
+
+                // Bytes requested from the file per read. Records are framed in place in
+                // this buffer (never smaller than one max-size record); a record cut by
+                // the end of one read is completed by the next.
+                std::size_t read_block_bytes = 1024 * 1024;
+
+                // Read-ahead: a background thread reads the next read_block_bytes
+                // chunks (up to read_ahead_buffers - 1 of them) while records are
+                // framed and checked, so replay overlaps I/O with CRC/decode work.
+                bool read_ahead = false;
+                std::size_t read_ahead_buffers = 3;
+
+                // io_uring read-ahead (Linux): the same read_ahead_buffers chunks are
+                // kept queued as io_uring reads into registered buffers, without a
+                // background thread. Falls back to the read-ahead thread (if
+                // read_ahead is set) or plain reads if the kernel refuses io_uring.
+                bool io_uring = false;
             };
 
             // Open file + validate header. Throws ParseError on invalid format.
@@ -51,8 +73,57 @@ namespace telemetry {
             //   false -> clean EOF (no more records)
             //
             // Throws ParseError on corruption/truncation/oversized packet.
+            //
+            // Block-compressed files (format::kFlagBlockCompressed) are read the same
+            // way: each block is checked and decompressed when its first record is read.
             bool read_next(std::vector<std::uint8_t>& out_packet);
 
+            // Same checks, without the copy: out_packet views the payload inside the
+            // reader's buffer and stays valid until the next read or seek. Never
+            // allocates (block-compressed files reuse one block buffer).
+            bool read_next(std::span<const std::uint8_t>& out_packet);
+
+            // ---- Batched replay ----
+
+            // Reads up to max_records records whose payloads total at most max_bytes
+            // (a single larger record is still returned on its own), with the same
+            // checks as read_next(). An empty batch means clean EOF.
+            // A record that fails its checks is not consumed: the records before it
+            // are returned, and the next call throws the ParseError read_next() would.
+            // Throws std::invalid_argument if max_records is 0 (nothing is consumed).
+            PacketBatch read_batch(std::size_t max_records, std::size_t max_bytes);
+
+            // Same, refilling out (its capacity is reused). Returns false at clean EOF.
+            bool read_batch(PacketBatch& out, std::size_t max_records, std::size_t max_bytes);
+
+            // ---- Sparse index (format::kFlagIndexed) ----
+
+            // True if the file carries a valid index footer.
+            bool has_index() const noexcept { return indexed_; }
+
+            // Records between index entries (0 without an index).
+            std::uint32_t index_interval() const noexcept { return indexed_ ? index_interval_ : 0; }
+
+            // Total records in the file (from the index footer; 0 without an index).
+            std::uint64_t record_count() const noexcept { return indexed_ ? index_record_count_ : 0; }
+
+            // Number of the record the next read_next() returns (0-based).
+            std::uint64_t record_number() const noexcept { return next_record_; }
+
+            // Positions the reader so the next read_next() returns record n.
+            // With an index this is a binary search plus fewer than index_interval()
+            // size-field skips; without one it skips from the first record.
+            // Returns false if the file holds n records or fewer (reader is left at EOF).
+            // Throws ParseError if a skipped size field is corrupt.
+            bool seek_to_record(std::uint64_t n);
+
+            // Positions the reader at the last indexed record whose timestamp is < ms
+            // (or at the first record) and returns its record number. The first record
+            // at or after ms is then at most index_interval() records ahead, even when
+            // several records share the timestamp ms.
+            // Throws ParseError if the file has no index.
+            std::uint64_t seek_to_time(std::uint64_t ms);
+
         private:
             TelemetryReader(std::ifstream file,
                             std::uint16_t version,
@@ -67,7 +138,35 @@ namespace telemetry {
             static bool read_exact(std::istream& in, std::span<std::uint8_t> buf);
 
             static std::uint16_t read_u16_le(std::istream& in);
-            static std::uint32_t read_u32_le(std::istream& in);
+
+            // Makes at least `need` bytes from position_ available in buf_ (fewer only
+            // at the end of record data) and returns how many are available.
+            std::size_t fill(std::size_t need);
+
+            // Frames the next record in buf_ without checking its CRC.
+            // Returns false at clean EOF / end of record data.
+            bool next_record(RecordView& out);
+
+            // Loads the index footer if the header flags announce one.
+            void load_index(std::uint64_t file_size);
+
+            // Opt-in read-ahead (Options::read_ahead / io_uring), after the index is loaded.
+            void start_read_ahead(const std::filesystem::path& path);
+
+            // Moves the stream to a record boundary (a block boundary in block mode).
+            void seek_to_offset(std::uint64_t offset, std::uint64_t record_number);
+
+            // Block mode: frames the next record, loading the next block when the
+            // current one is used up. Returns false at the end of record data.
+            bool next_block_record(RecordView& out);
+            bool load_block();
+
+            // Frames the next record in either layout and reports its file offset
+            // (its block's offset in block mode).
+            bool frame_next(RecordView& out, std::uint64_t& file_offset);
+
+            // Puts back the record frame_next() just returned.
+            void unread(const RecordView& record) noexcept;
 
             std::ifstream file_;
             std::uint16_t version_{0};
@@ -75,6 +174,30 @@ namespace telemetry {
             Options opt_;
             telemetry::Logger& logger_;
 
+            std::uint64_t position_{0};    // file offset of the next record (of buf_[buf_pos_])
+            std::uint64_t next_record_{0};
+            std::uint64_t data_end_{0};    // end of record data (footer start or file size)
+
+            bool indexed_{false};
+            std::uint32_t index_interval_{0};
+            std::uint64_t index_record_count_{0};
+            std::vector<std::uint64_t> index_offsets_;
+            std::vector<std::uint64_t> index_timestamps_;
+
+            // Read buffer: file bytes [position_ - buf_pos_, position_ + (buf_end_ - buf_pos_))
+            std::vector<std::uint8_t> buf_;
+            std::size_t buf_pos_{0};
+            std::size_t buf_end_{0};
+            bool eof_{false};              // the last read hit EOF / the index footer
+
+            std::unique_ptr<ChunkSource> read_ahead_;   // replaces file_ reads when set
+            std::span<const std::uint8_t> ahead_;       // unconsumed part of the current chunk
+
+            bool blocks_{false};
+            std::vector<std::uint8_t> block_;         // records of the current block
+            std::size_t block_pos_{0};                // next record within block_
+            std::uint64_t block_offset_{0};           // file offset of the current block
+
     };
 
 } // namespace telemetry
@@ -1,11 +1,22 @@
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <span>
+#include <thread>
+#include <vector>
 
+#include "telemetry/DirectWriter.h"
+#include "telemetry/IoUring.h"
 #include "telemetry/Logger.h"
+#include "telemetry/RecordFraming.h"
+#include "telemetry/TelemetryFormat.h"
 
 namespace telemetry {
 
@@ -16,11 +27,81 @@ class TelemetryRecorder {
             Append    // append new packets to end
         };
 
+        // What an async producer does when both buffers are full
+        enum class Backpressure {
+            Block, // wait for the writer thread to free a buffer
+            Drop   // discard the packet (counted in Stats::dropped_packets)
+        };
+
+        struct Options {
+            // Async mode: producers frame records into an in-memory buffer and a
+            // background thread swaps buffers and drains them to disk.
+            bool async = false;
+            std::size_t async_buffer_bytes = 1024 * 1024; // capacity of each of the two buffers
+            Backpressure backpressure = Backpressure::Block;
+
+            // > 0: keep a sparse index entry (file offset + timestamp) every N records
+            // and write it as a footer on close (header flag format::kFlagIndexed).
+            // Appending to an indexed file continues its index with the file's interval.
+            std::uint32_t index_interval = 0;
+
+            // Payload encoding bits (format::kPayloadFlagsMask, e.g. kFlagCompactFrames)
+            // stored in the header flags for readers. The recorder still frames
+            // payloads as-is. Appending requires the same bits as the existing file.
+            // kFlagCompactFrames payloads depend on the record before them, so the
+            // constructor throws std::invalid_argument if combined with async
+            // Backpressure::Drop.
+            std::uint16_t payload_flags = 0;
+
+            // Block mode (header flag format::kFlagBlockCompressed): records are
+            // collected into blocks of about block_bytes, and each block is
+            // LZ-compressed as it is written (on the writer thread in async mode).
+            // flush() closes the open block early. With an index, every indexed record
+            // starts a new block, so keep index_interval x record size >= block_bytes.
+            // Appending keeps the existing file's layout.
+            bool compress_blocks = false;
+            std::size_t block_bytes = format::kDefaultBlockBytes;
+
+            // io_uring writes (Linux): bytes are copied into io_uring_buffers
+            // registered buffers of io_uring_buffer_bytes, and each full buffer is
+            // written at its file offset without waiting, so up to
+            // io_uring_buffers x io_uring_buffer_bytes are in flight at once.
+            // flush() waits for them. Falls back to the ofstream if the kernel
+            // refuses io_uring. The file contents are identical either way.
+            bool io_uring = false;
+            std::size_t io_uring_buffer_bytes = 1024 * 1024;
+            std::size_t io_uring_buffers = 4;
+
+            // O_DIRECT writes (Linux): bytes are staged in a 4 KiB-aligned buffer of
+            // direct_buffer_bytes and written around the page cache, so a long
+            // capture neither evicts other data nor stalls on writeback. flush()
+            // and close write the partial last block zero-padded and truncate the
+            // padding away, so readers see the same file as in stream mode.
+            // Falls back to the ofstream if the filesystem rejects O_DIRECT.
+            // Takes precedence over io_uring.
+            bool direct_io = false;
+            std::size_t direct_buffer_bytes = 1024 * 1024;
+        };
+
+        struct Stats {
+            std::size_t queued_bytes = 0;        // accepted but not yet written to the stream
+            std::size_t max_queued_bytes = 0;    // high-water mark of queued_bytes
+            std::uint64_t bytes_written = 0;     // framed bytes handed to the stream (before block compression)
+            std::uint64_t dropped_packets = 0;   // Backpressure::Drop only
+            std::uint64_t stalls = 0;            // times a producer had to wait (Backpressure::Block)
+            std::chrono::nanoseconds stall_time{0};
+        };
+
         TelemetryRecorder(const std::filesystem::path& path,
                         telemetry::Logger& logger,
                         OpenMode mode);
 
+        TelemetryRecorder(const std::filesystem::path& path,
+                        telemetry::Logger& logger,
+                        OpenMode mode,
+                        Options opt);
 
+        // Async mode: drains all queued records before closing the file.
         ~TelemetryRecorder();
 
         // Non-copyable (owning a file handle should not be copied)
@@ -31,11 +112,129 @@ class TelemetryRecorder {
         // [u32 size][packet bytes...][u32 crc]
         void write_packet(std::span<const std::uint8_t> packet_bytes);
 
+        // Same, tagging the record with its timestamp for the sparse index.
+        // Packets written without a timestamp inherit the previous one.
+        // Timestamps must be non-decreasing (seek_to_time binary-searches them):
+        // an earlier timestamp is clamped to the previous one, with a warning.
+        void write_packet(std::span<const std::uint8_t> packet_bytes, std::uint64_t timestamp_ms);
+
+        // Write a batch of framed packets with a single stream write and one log line.
+        // The bytes on disk are identical to calling write_packet() for each packet.
+        // Sizes are validated up front: if any packet is too large nothing is written.
+        void write_packets(std::span<const std::span<const std::uint8_t>> packets);
+
+        // Same, with one timestamp per packet for the sparse index.
+        void write_packets(std::span<const std::span<const std::uint8_t>> packets,
+                           std::span<const std::uint64_t> timestamps_ms);
+
+        // Sync mode: flushes the output stream.
+        // Async mode: waits until every record accepted so far is written, then
+        // flushes the stream and fsyncs the file so the data is durable.
         void flush();
 
+        // Counters for the async queue (all zero except bytes_written in sync mode).
+        Stats stats() const;
+
+        // Header flags of the file being written (format::kFlag*)
+        std::uint16_t flags() const noexcept;
+
+        // Records between index entries, or 0 if the file is not indexed
+        std::uint32_t index_interval() const noexcept { return indexing_ ? index_interval_ : 0; }
+
+        // Records in the file so far, including those accepted but not yet written.
+        // Counts from the existing records when appending to an indexed file.
+        std::uint64_t record_count() const;
+
+        // True if writes go through io_uring (Options::io_uring and the kernel allows it)
+        bool using_io_uring() const noexcept { return uring_ != nullptr; }
+
+        // True if writes bypass the page cache (Options::direct_io and the filesystem allows it)
+        bool using_direct_io() const noexcept { return direct_ != nullptr; }
+
     private:
+        std::filesystem::path path_;
         std::ofstream out_;
+        std::unique_ptr<UringWriter> uring_;   // replaces out_ writes when set
+        std::unique_ptr<DirectWriter> direct_; // same, for O_DIRECT writes
         telemetry::Logger& logger_;
-        void write_u32_le(std::uint32_t);
+        Options opt_;
+
+        // Reused framing buffer so each write is one ofstream::write call
+        std::vector<std::uint8_t> staging_;
+
+        std::uint16_t payload_flags_ = 0;
+
+        // ---- Sparse index (guarded by mutex_ in async mode) ----
+        bool indexing_ = false;
+        std::uint32_t index_interval_ = 0;
+        std::vector<IndexEntry> index_;
+        std::uint64_t record_count_ = 0;
+        std::uint64_t next_offset_ = 0;     // file offset of the next record
+        std::uint64_t last_timestamp_ = 0;
+
+        // ---- Block mode (guarded by io_mutex_ in async mode) ----
+        bool blocks_ = false;
+        std::size_t block_limit_ = 0;
+        std::vector<std::uint8_t> block_;          // raw records of the open block
+        std::vector<std::uint8_t> block_out_;      // header + stored bytes of a finished block
+        std::vector<std::uint8_t> block_scratch_;  // compressor output
+        std::uint64_t block_record_ = 0;           // number of the next record added to a block
+        std::uint64_t block_offset_ = 0;           // file offset of the next block
+        std::vector<std::uint64_t> block_index_offsets_;  // blocks that start at an indexed record
+        std::size_t first_block_entry_ = 0;        // earlier index_ entries (from the file) are final
+
+        // ---- Async mode state (guarded by mutex_) ----
+        mutable std::mutex mutex_;
+        std::condition_variable data_ready_;   // producer -> writer
+        std::condition_variable space_ready_;  // writer -> blocked producers
+        std::condition_variable written_;      // writer -> flush()
+        std::vector<std::uint8_t> front_;      // producers append here
+        std::vector<std::uint8_t> back_;       // writer thread drains this one
+        std::uint64_t accepted_bytes_ = 0;
+        std::uint64_t written_bytes_ = 0;
+        bool stopping_ = false;
+        std::exception_ptr writer_error_;
+        Stats stats_;
+        std::mutex io_mutex_;                  // serializes out_ between writer and flush()
+        std::thread writer_;
+
+        // Framed record size; throws if the packet does not fit the u32 size field.
+        std::size_t framed_size(std::span<const std::uint8_t> packet_bytes);
+
+        // Appends [u32 size][payload][u32 crc] to buffer and returns the CRC.
+        static std::uint32_t append_record(std::vector<std::uint8_t>& buffer,
+                                           std::span<const std::uint8_t> packet_bytes);
+        void write_staging();
+
+        // Every byte of the file goes through these: out_, or direct_ / uring_ when
+        // set. Their failures are rethrown as std::ios_base::failure like stream errors.
+        void write_out(std::span<const std::uint8_t> bytes);
+        void flush_out();
+
+        // Hands whole framed records to the file: directly, or via the open block.
+        void write_records(std::span<const std::uint8_t> framed);
+
+        // Block mode: compresses and writes the open block (no-op if empty).
+        void write_block();
+
+        // Prepares an append to an existing file: adopts (and strips) its index footer.
+        void open_existing_for_append(const std::filesystem::path& path);
+
+        void write_single(std::span<const std::uint8_t> packet_bytes,
+                          std::span<const std::uint64_t> timestamp_ms);
+        void write_batch(std::span<const std::span<const std::uint8_t>> packets,
+                         std::span<const std::uint64_t> timestamps_ms);
+
+        // Advances record offsets / count and samples index entries for accepted packets.
+        void note_records(std::span<const std::span<const std::uint8_t>> packets,
+                          std::span<const std::uint64_t> timestamps_ms);
+        void write_index_footer();
+
+        // Async mode: queue framed records; returns false if dropped.
+        bool enqueue(std::span<const std::span<const std::uint8_t>> packets,
+                     std::span<const std::uint64_t> timestamps_ms);
+        void writer_loop();
+        void stop_writer();
+        void rethrow_writer_error();
     };
 } // namespace telemetry
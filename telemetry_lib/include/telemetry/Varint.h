@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace telemetry {
+
+    // LEB128: 7 value bits per byte, low group first, high bit set on every
+    // byte except the last. Values below 128 take one byte; a u64 at most 10.
+    inline constexpr std::size_t kMaxVarintBytes = 10;
+
+    constexpr std::size_t varint_size(std::uint64_t value) noexcept {
+        std::size_t n = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            n++;
+        }
+        return n;
+    }
+
+    // ZigZag maps signed to unsigned so small magnitudes stay small:
+    // 0, -1, 1, -2, 2 ... -> 0, 1, 2, 3, 4 ...
+    constexpr std::uint64_t zigzag_encode(std::int64_t value) noexcept {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    constexpr std::int64_t zigzag_decode(std::uint64_t value) noexcept {
+        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+    }
+
+    static_assert(zigzag_decode(zigzag_encode(-3)) == -3 && zigzag_encode(-1) == 1 && zigzag_encode(1) == 2);
+    static_assert(varint_size(127) == 1 && varint_size(128) == 2 && varint_size(~0ull) == kMaxVarintBytes);
+
+} // namespace telemetry
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include "telemetry/Logger.h"
+
+namespace telemetry {
+
+    struct VerifyOptions {
+        std::size_t max_packet_size = 64 * 1024; // same cap as TelemetryReader::Options
+        unsigned threads = 0;                    // 0 = std::thread::hardware_concurrency()
+    };
+
+    struct VerifyReport {
+        std::uint64_t records = 0;       // records framed (including bad ones)
+        std::uint64_t bad_records = 0;   // records whose CRC does not match
+        std::uint64_t bytes = 0;         // record bytes checked (size fields + payloads + CRCs;
+                                         // block headers + stored bytes for compressed files)
+        std::uint64_t bad_blocks = 0;    // compressed blocks that fail their CRC or do not decode
+
+        // First problem in file order, worded exactly like the ParseError that
+        // TelemetryReader::open()/read_next() throws for the same file. Empty if clean.
+        std::string error;
+        std::uint64_t error_offset = 0;  // file offset of the failing record (0 for header errors)
+        std::uint64_t error_record = 0;  // records read_next() returns before throwing
+
+        unsigned threads = 0;
+        std::chrono::nanoseconds elapsed{0};
+
+        bool ok() const noexcept { return error.empty(); }
+        double throughput_mb_s() const noexcept;
+    };
+
+    // Verifies every record CRC of a recording without decoding it.
+    //
+    // One pass over the size fields splits the (memory-mapped) file into chunks of
+    // whole records; the chunks' CRCs are then checked on a pool of threads.
+    // Unlike read_next(), verification continues past CRC mismatches so every bad
+    // record is counted. A framing error (bad size, truncation) ends the walk,
+    // since nothing after it can be located.
+    //
+    // Block-compressed files (format::kFlagBlockCompressed) are split on block
+    // boundaries; each worker checks, decompresses and walks its blocks. A bad
+    // block is counted and skipped, since the next block header still locates
+    // the rest of the file.
+    //
+    // Format problems are reported in the VerifyReport, not thrown.
+    VerifyReport verify_recording(const std::filesystem::path& path,
+                                  VerifyOptions opt,
+                                  telemetry::Logger& logger);
+
+} // namespace telemetry
@@ -0,0 +1,49 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "telemetry/BitStream.h"
+
+namespace telemetry {
+
+    void BitWriter::flush_word() {
+        std::uint64_t be = std::endian::native == std::endian::big ? acc_ : byteswap(acc_);
+        const std::size_t at = buffer_.size();
+        buffer_.resize(at + sizeof(be));
+        std::memcpy(buffer_.data() + at, &be, sizeof(be));
+        acc_ = 0;
+        used_ = 0;
+    }
+
+    std::span<const std::uint8_t> BitWriter::finish() {
+        padding_ += (8 - used_ % 8) % 8;
+        for (unsigned shift = 56; used_ > 0; shift -= 8) {
+            buffer_.push_back(static_cast<std::uint8_t>(acc_ >> shift));
+            used_ = used_ > 8 ? used_ - 8 : 0;
+        }
+        acc_ = 0;
+        return buffer_;
+    }
+
+    void BitWriter::clear() noexcept {
+        buffer_.clear();
+        acc_ = 0;
+        used_ = 0;
+        padding_ = 0;
+    }
+
+    std::uint64_t BitReader::load_tail(std::size_t byte) const noexcept {
+        std::uint64_t window = 0;
+        for (std::size_t i = 0; i < sizeof(window); i++) {
+            window <<= 8;
+            if (byte + i < data_.size()) {
+                window |= data_[byte + i];
+            }
+        }
+        return window;
+    }
+
+    void BitReader::throw_exhausted() {
+        throw std::out_of_range("no remaining bits to read");
+    }
+
+} // namespace telemetry
@@ -1,26 +1,325 @@
+#include <array>
+#include <cstddef>
+
 #include "telemetry/CRC.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define TELEMETRY_CRC_X86 1
+#endif
+
+// All engines work on the raw CRC register (before the final xor) so they can
+// be chained: process part of a buffer with one engine, the rest with another.
+
 namespace telemetry {
 
-    std::uint32_t crc32(const std::span<const std::uint8_t>& data) {
-        std::uint32_t polynomial = 0x04C11DB7;
-        std::uint32_t crc = 0xFFFFFFFF;
-
-        for (std::uint8_t byte : data) {
-            byte ^= static_cast<std::uint8_t>((crc >> 24) & 0xFF);
-            crc = (crc & 0x00FFFFFF) | (static_cast<std::uint32_t>(byte) << 24);
-
-            for (int i = 0; i < 8; i++) {
-                if (crc & 0x80000000) {
-                    crc = (crc << 1) ^ polynomial;
-                } else {
-                    crc <<= 1;
+    namespace {
+
+        constexpr std::uint32_t kPolynomial = 0x04C11DB7;
+        constexpr std::uint32_t kInitXor = 0xFFFFFFFF;
+
+        // Lookup tables for slicing-by-N.
+        // tables[0][b]  = register contribution of byte b.
+        // tables[k][b]  = contribution of byte b followed by k zero bytes.
+        using CrcTables = std::array<std::array<std::uint32_t, 256>, 16>;
+
+        constexpr CrcTables make_tables() {
+            CrcTables t{};
+            for (std::uint32_t i = 0; i < 256; i++) {
+                std::uint32_t crc = i << 24;
+                for (int bit = 0; bit < 8; bit++) {
+                    crc = (crc & 0x80000000) ? (crc << 1) ^ kPolynomial : (crc << 1);
+                }
+                t[0][i] = crc;
+            }
+            for (std::size_t k = 1; k < t.size(); k++) {
+                for (std::size_t i = 0; i < 256; i++) {
+                    std::uint32_t prev = t[k - 1][i];
+                    t[k][i] = (prev << 8) ^ t[0][prev >> 24];
+                }
+            }
+            return t;
+        }
+
+        constexpr CrcTables kTables = make_tables();
+
+        inline std::uint32_t load_be32(const std::uint8_t* p) {
+            return (static_cast<std::uint32_t>(p[0]) << 24) |
+                   (static_cast<std::uint32_t>(p[1]) << 16) |
+                   (static_cast<std::uint32_t>(p[2]) << 8) |
+                    static_cast<std::uint32_t>(p[3]);
+        }
+
+        std::uint32_t update_bitwise(std::uint32_t crc, const std::uint8_t* p, std::size_t n) {
+            for (std::size_t idx = 0; idx < n; idx++) {
+                std::uint8_t byte = p[idx];
+                byte ^= static_cast<std::uint8_t>((crc >> 24) & 0xFF);
+                crc = (crc & 0x00FFFFFF) | (static_cast<std::uint32_t>(byte) << 24);
+
+                for (int i = 0; i < 8; i++) {
+                    if (crc & 0x80000000) {
+                        crc = (crc << 1) ^ kPolynomial;
+                    } else {
+                        crc <<= 1;
+                    }
+                }
+            }
+            return crc;
+        }
+
+        inline std::uint32_t update_bytewise(std::uint32_t crc, const std::uint8_t* p, std::size_t n) {
+            for (std::size_t i = 0; i < n; i++) {
+                crc = (crc << 8) ^ kTables[0][(crc >> 24) ^ p[i]];
+            }
+            return crc;
+        }
+
+        std::uint32_t update_slice8(std::uint32_t crc, const std::uint8_t* p, std::size_t n) {
+            while (n >= 8) {
+                std::uint32_t w = crc ^ load_be32(p);
+                crc = kTables[7][w >> 24] ^
+                      kTables[6][(w >> 16) & 0xFF] ^
+                      kTables[5][(w >> 8) & 0xFF] ^
+                      kTables[4][w & 0xFF] ^
+                      kTables[3][p[4]] ^
+                      kTables[2][p[5]] ^
+                      kTables[1][p[6]] ^
+                      kTables[0][p[7]];
+                p += 8;
+                n -= 8;
+            }
+            return update_bytewise(crc, p, n);
+        }
+
+        std::uint32_t update_slice16(std::uint32_t crc, const std::uint8_t* p, std::size_t n) {
+            while (n >= 16) {
+                std::uint32_t w = crc ^ load_be32(p);
+                crc = kTables[15][w >> 24] ^
+                      kTables[14][(w >> 16) & 0xFF] ^
+                      kTables[13][(w >> 8) & 0xFF] ^
+                      kTables[12][w & 0xFF] ^
+                      kTables[11][p[4]] ^
+                      kTables[10][p[5]] ^
+                      kTables[9][p[6]] ^
+                      kTables[8][p[7]] ^
+                      kTables[7][p[8]] ^
+                      kTables[6][p[9]] ^
+                      kTables[5][p[10]] ^
+                      kTables[4][p[11]] ^
+                      kTables[3][p[12]] ^
+                      kTables[2][p[13]] ^
+                      kTables[1][p[14]] ^
+                      kTables[0][p[15]];
+                p += 16;
+                n -= 16;
+            }
+            return update_bytewise(crc, p, n);
+        }
+
+#if defined(TELEMETRY_CRC_X86)
+
+        // x^n mod P, used for the folding constants.
+        constexpr std::uint32_t xpow_mod(unsigned n) {
+            std::uint32_t r = 1;
+            for (unsigned i = 0; i < n; i++) {
+                r = (r & 0x80000000) ? (r << 1) ^ kPolynomial : (r << 1);
+            }
+            return r;
+        }
+
+        // Folding a 128-bit lane forward by F bits:
+        //   L * x^F = L_hi * x^(F+64) + L_lo * x^F  (each constant reduced mod P)
+        constexpr std::uint32_t kFold512Hi = xpow_mod(512 + 64);
+        constexpr std::uint32_t kFold512Lo = xpow_mod(512);
+        constexpr std::uint32_t kFold128Hi = xpow_mod(128 + 64);
+        constexpr std::uint32_t kFold128Lo = xpow_mod(128);
+
+        __attribute__((target("pclmul,ssse3")))
+        inline __m128i byte_reverse_mask() {
+            return _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                8, 9, 10, 11, 12, 13, 14, 15);
+        }
+
+        __attribute__((target("pclmul,ssse3")))
+        inline __m128i load_lane(const std::uint8_t* src, __m128i bswap) {
+            return _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)), bswap);
+        }
+
+        __attribute__((target("pclmul,ssse3")))
+        inline __m128i fold_lane(__m128i x, __m128i k, __m128i next) {
+            __m128i hi = _mm_clmulepi64_si128(x, k, 0x11);
+            __m128i lo = _mm_clmulepi64_si128(x, k, 0x00);
+            return _mm_xor_si128(_mm_xor_si128(hi, lo), next);
+        }
+
+        // Non-reflected CRC maps directly onto PCLMULQDQ once each 16-byte lane is
+        // byte-reversed (first message byte -> highest polynomial coefficients).
+        // The message is folded down to one 128-bit value congruent mod P, which is
+        // then finished with the table engine together with the sub-16-byte tail.
+        __attribute__((target("pclmul,ssse3")))
+        std::uint32_t update_pclmul(std::uint32_t crc, const std::uint8_t* p, std::size_t n) {
+            if (n < 64) {
+                return update_slice16(crc, p, n);
+            }
+
+            const __m128i bswap = byte_reverse_mask();
+            const __m128i k512 = _mm_set_epi64x(kFold512Hi, kFold512Lo);
+            const __m128i k128 = _mm_set_epi64x(kFold128Hi, kFold128Lo);
+
+            // Injecting the running register into the top 32 bits of the message
+            // is equivalent to continuing the CRC from that register value.
+            __m128i x0 = _mm_xor_si128(load_lane(p, bswap), _mm_set_epi32(static_cast<int>(crc), 0, 0, 0));
+            __m128i x1 = load_lane(p + 16, bswap);
+            __m128i x2 = load_lane(p + 32, bswap);
+            __m128i x3 = load_lane(p + 48, bswap);
+            p += 64;
+            n -= 64;
+
+            while (n >= 64) {
+                x0 = fold_lane(x0, k512, load_lane(p, bswap));
+                x1 = fold_lane(x1, k512, load_lane(p + 16, bswap));
+                x2 = fold_lane(x2, k512, load_lane(p + 32, bswap));
+                x3 = fold_lane(x3, k512, load_lane(p + 48, bswap));
+                p += 64;
+                n -= 64;
+            }
+
+            __m128i acc = fold_lane(x0, k128, x1);
+            acc = fold_lane(acc, k128, x2);
+            acc = fold_lane(acc, k128, x3);
+
+            while (n >= 16) {
+                acc = fold_lane(acc, k128, load_lane(p, bswap));
+                p += 16;
+                n -= 16;
+            }
+
+            alignas(16) std::uint8_t folded[16];
+            _mm_store_si128(reinterpret_cast<__m128i*>(folded), _mm_shuffle_epi8(acc, bswap));
+
+            crc = update_slice16(0, folded, sizeof(folded));
+            return update_slice16(crc, p, n);
+        }
+
+        bool cpu_has_pclmul() noexcept {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("ssse3");
+        }
+
+#else
+
+        std::uint32_t update_pclmul(std::uint32_t crc, const std::uint8_t* p, std::size_t n) {
+            return update_slice16(crc, p, n);
+        }
+
+        bool cpu_has_pclmul() noexcept {
+            return false;
+        }
+
+#endif
+
+        // a * b mod P for polynomials of degree < 32.
+        constexpr std::uint32_t multiply_mod(std::uint32_t a, std::uint32_t b) {
+            std::uint32_t product = 0;
+            for (int i = 31; i >= 0; i--) {
+                product = (product & 0x80000000) ? (product << 1) ^ kPolynomial : (product << 1);
+                if (b & (1u << i)) {
+                    product ^= a;
                 }
             }
+            return product;
+        }
+
+        // kZeroBytePowers[k] = x^(8 * 2^k) mod P: shifting a CRC register over 2^k zero bytes.
+        using PowerTable = std::array<std::uint32_t, 64>;
+
+        constexpr PowerTable make_zero_byte_powers() {
+            PowerTable t{};
+            t[0] = 0x100; // x^8
+            for (std::size_t k = 1; k < t.size(); k++) {
+                t[k] = multiply_mod(t[k - 1], t[k - 1]);
+            }
+            return t;
+        }
+
+        constexpr PowerTable kZeroBytePowers = make_zero_byte_powers();
+
+        using UpdateFn = std::uint32_t (*)(std::uint32_t, const std::uint8_t*, std::size_t);
+
+        bool pclmul_supported() noexcept {
+            static const bool supported = cpu_has_pclmul();
+            return supported;
+        }
+
+        UpdateFn select_engine(Crc32Engine engine) noexcept {
+            switch (engine) {
+                case Crc32Engine::Bitwise: return update_bitwise;
+                case Crc32Engine::Slice8:  return update_slice8;
+                case Crc32Engine::Slice16: return update_slice16;
+                case Crc32Engine::Pclmul:  return pclmul_supported() ? update_pclmul : update_slice16;
+            }
+            return update_slice16;
         }
 
-        crc ^= 0xFFFFFFFF;
-        return crc;
+        UpdateFn best_engine() noexcept {
+            static const UpdateFn best = select_engine(crc32_active_engine());
+            return best;
+        }
+
+    } // namespace
+
+    std::uint32_t crc32(const std::span<const std::uint8_t>& data) {
+        return best_engine()(kInitXor, data.data(), data.size()) ^ kInitXor;
+    }
+
+    std::uint32_t crc32(const std::span<const std::uint8_t>& data, Crc32Engine engine) {
+        return select_engine(engine)(kInitXor, data.data(), data.size()) ^ kInitXor;
+    }
+
+    Crc32& Crc32::update(std::span<const std::uint8_t> data) noexcept {
+        state_ = best_engine()(state_, data.data(), data.size());
+        return *this;
+    }
+
+    std::uint32_t Crc32::value() const noexcept {
+        return state_ ^ kInitXor;
+    }
+
+    void Crc32::reset() noexcept {
+        state_ = kInitXor;
+    }
+
+    std::uint32_t crc32_combine(std::uint32_t crc_a, std::uint32_t crc_b, std::uint64_t len_b) noexcept {
+        // With init == xorout the two constants cancel out:
+        //   crc(A || B) = crc(A) * x^(8 * len_b) mod P  ^  crc(B)
+        std::uint32_t shifted = crc_a;
+        for (std::size_t k = 0; len_b != 0; k++, len_b >>= 1) {
+            if (len_b & 1) {
+                shifted = multiply_mod(shifted, kZeroBytePowers[k]);
+            }
+        }
+        return shifted ^ crc_b;
+    }
+
+    bool crc32_engine_supported(Crc32Engine engine) noexcept {
+        if (engine == Crc32Engine::Pclmul) {
+            return pclmul_supported();
+        }
+        return true;
+    }
+
+    Crc32Engine crc32_active_engine() noexcept {
+        return pclmul_supported() ? Crc32Engine::Pclmul : Crc32Engine::Slice16;
+    }
+
+    const char* to_string(Crc32Engine engine) noexcept {
+        switch (engine) {
+            case Crc32Engine::Bitwise: return "bitwise";
+            case Crc32Engine::Slice8:  return "slice8";
+            case Crc32Engine::Slice16: return "slice16";
+            case Crc32Engine::Pclmul:  return "pclmul";
+        }
+        return "unknown";
     }
 
-}
\ No newline at end of file
+}
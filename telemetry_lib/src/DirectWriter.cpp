@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "telemetry/DirectWriter.h"
+
+namespace telemetry {
+
+    namespace {
+
+        std::runtime_error io_error(const std::string& what, int err) {
+            return std::runtime_error("DirectWriter: " + what + ": " + std::strerror(err));
+        }
+
+    } // namespace
+
+    DirectWriter::DirectWriter(const std::filesystem::path& path,
+                               std::uint64_t offset,
+                               std::size_t buffer_bytes)
+        : base_(offset - offset % kAlignment) {
+#ifdef O_DIRECT
+        fd_ = ::open(path.c_str(), O_RDWR | O_CLOEXEC | O_DIRECT);
+#else
+        errno = ENOTSUP;
+#endif
+        if (fd_ < 0) {
+            const int err = errno;
+            throw io_error("O_DIRECT open failed for " + path.string(), err);
+        }
+
+        const std::size_t blocks = std::max<std::size_t>(1, (buffer_bytes + kAlignment - 1) / kAlignment);
+        buffer_.resize(blocks * kAlignment);
+
+        // Appending mid-block: the block is rewritten whole, so start from its current bytes
+        fill_ = static_cast<std::size_t>(offset - base_);
+        if (fill_ > 0) {
+            ssize_t got;
+            do {
+                got = ::pread(fd_, buffer_.data(), kAlignment, static_cast<off_t>(base_));
+            } while (got < 0 && errno == EINTR);
+            if (got < static_cast<ssize_t>(fill_)) {
+                const int err = got < 0 ? errno : EIO;
+                ::close(fd_);
+                throw io_error("reading the last block failed", err);
+            }
+        }
+    }
+
+    DirectWriter::~DirectWriter() {
+        ::close(fd_);
+    }
+
+    void DirectWriter::write(std::span<const std::uint8_t> bytes) {
+        while (!bytes.empty()) {
+            const std::size_t n = std::min(bytes.size(), buffer_.size() - fill_);
+            std::memcpy(buffer_.data() + fill_, bytes.data(), n);
+            fill_ += n;
+            bytes = bytes.subspan(n);
+            if (fill_ == buffer_.size()) {
+                write_aligned(fill_);
+                base_ += fill_;
+                fill_ = 0;
+            }
+        }
+    }
+
+    void DirectWriter::flush() {
+        if (fill_ == 0) {
+            return;
+        }
+
+        // Zero-pad to a whole block, write, then cut the padding off again
+        const std::size_t padded = (fill_ + kAlignment - 1) / kAlignment * kAlignment;
+        std::memset(buffer_.data() + fill_, 0, padded - fill_);
+        write_aligned(padded);
+        if (::ftruncate(fd_, static_cast<off_t>(base_ + fill_)) != 0) {
+            throw io_error("ftruncate failed", errno);
+        }
+
+        // Keep only the partial block; the next flush rewrites it at the same offset
+        const std::size_t whole = fill_ / kAlignment * kAlignment;
+        std::memmove(buffer_.data(), buffer_.data() + whole, fill_ - whole);
+        base_ += whole;
+        fill_ -= whole;
+    }
+
+    void DirectWriter::write_aligned(std::size_t bytes) {
+        std::size_t done = 0;
+        while (done < bytes) {
+            ssize_t put = ::pwrite(fd_, buffer_.data() + done, bytes - done, static_cast<off_t>(base_ + done));
+            if (put < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw io_error("write failed", errno);
+            }
+            if (put == 0) {
+                throw io_error("write made no progress", EIO);
+            }
+            done += static_cast<std::size_t>(put);
+        }
+    }
+
+} // namespace telemetry
@@ -0,0 +1,118 @@
+#include <bit>
+
+#include "telemetry/FloatXorCodec.h"
+
+namespace telemetry {
+
+    namespace {
+
+        // '111' costs 5 more header bits than '110' and saves the trailing zeros
+        constexpr unsigned kTrimTrailing = 5;
+
+        // '110' costs 6 more header bits than '10' and saves the extra leading zeros
+        constexpr unsigned kNewLeading = 6;
+
+    }
+
+    void FloatXorEncoder::encode(float value, BitWriter& out) {
+        const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+
+        if (first_) {
+            out.write_bits(bits, 32);
+            prev_ = bits;
+            first_ = false;
+            return;
+        }
+
+        const std::uint32_t x = bits ^ prev_;
+        prev_ = bits;
+
+        if (x == 0) {
+            out.write_bit(false);
+            return;
+        }
+
+        // x != 0, so leading <= 31 fits 5 bits and every length is 1..32
+        const unsigned leading = static_cast<unsigned>(std::countl_zero(x));
+        const unsigned trailing = static_cast<unsigned>(std::countr_zero(x));
+
+        // Control code, header and payload go out in one write (at most 45 bits)
+        if (trailing > kTrimTrailing) {
+            const unsigned length = 32 - leading - trailing;
+            const std::uint64_t header = (0b111u << 10) | (leading << 5) | (length - 1);
+            out.write_bits((header << length) | (x >> trailing), 13 + length);
+        } else if (leading >= leading_ && leading - leading_ < kNewLeading) {
+            // About the same zero prefix as before (the common case for noisy sensors)
+            const unsigned length = 32 - leading_;
+            out.write_bits((std::uint64_t{0b10} << length) | x, 2 + length);
+            return;
+        } else {
+            const unsigned length = 32 - leading;
+            const std::uint64_t header = (0b110u << 5) | leading;
+            out.write_bits((header << length) | x, 8 + length);
+        }
+        leading_ = leading;
+    }
+
+    void FloatXorEncoder::reset() noexcept {
+        *this = FloatXorEncoder{};
+    }
+
+    float FloatXorDecoder::decode(BitReader& in) {
+        if (first_) {
+            prev_ = static_cast<std::uint32_t>(in.read_bits(32));
+            first_ = false;
+            return std::bit_cast<float>(prev_);
+        }
+
+        // Branch on the control code, then read it together with what follows. Each
+        // value is one read_bits call, so a truncated stream throws before in or
+        // the decoder state change.
+        const auto code = static_cast<unsigned>(in.peek_bits(3));
+        if (code < 0b100) {
+            in.read_bits(1);
+            return std::bit_cast<float>(prev_);
+        }
+
+        std::uint32_t x;
+        if (code < 0b110) {
+            const unsigned length = 32 - leading_;
+            x = static_cast<std::uint32_t>(in.read_bits(2 + length) & (~std::uint64_t{0} >> (64 - length)));
+        } else if (code == 0b110) {
+            const auto leading = static_cast<unsigned>(in.peek_bits(8) & 0x1F);
+            const unsigned length = 32 - leading;
+            x = static_cast<std::uint32_t>(in.read_bits(8 + length) & (~std::uint64_t{0} >> (64 - length)));
+            leading_ = leading;
+        } else {
+            const auto header = static_cast<unsigned>(in.peek_bits(13) & 0x3FF);
+            const unsigned leading = header >> 5;
+            const unsigned length = (header & 0x1F) + 1;
+            // leading + length <= 32 for any encoder output; clamp a corrupt header
+            const unsigned shift = leading + length >= 32 ? 0 : 32 - leading - length;
+            const std::uint64_t payload = in.read_bits(13 + length) & (~std::uint64_t{0} >> (64 - length));
+            x = static_cast<std::uint32_t>(payload << shift);
+            leading_ = leading;
+        }
+        prev_ ^= x;
+        return std::bit_cast<float>(prev_);
+    }
+
+    void FloatXorDecoder::reset() noexcept {
+        *this = FloatXorDecoder{};
+    }
+
+    void encode_float_column(std::span<const float> values, BitWriter& out) {
+        FloatXorEncoder encoder;
+        for (float v : values) {
+            encoder.encode(v, out);
+        }
+    }
+
+    void decode_float_column(BitReader& in, std::span<float> out) {
+        FloatXorDecoder decoder;
+        for (float& v : out) {
+            v = decoder.decode(in);
+        }
+    }
+
+} // namespace telemetry
@@ -0,0 +1,553 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "telemetry/IoUring.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define TELEMETRY_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#endif
+
+namespace telemetry {
+
+    namespace {
+
+        // One request never moves more than this (the SQE length field is 32 bits)
+        constexpr std::size_t kMaxRequestBytes = std::size_t{1} << 30;
+
+        // IoUring::ops_ bits
+        constexpr unsigned kOpRead = 1u << 0;
+        constexpr unsigned kOpWrite = 1u << 1;
+        constexpr unsigned kOpReadFixed = 1u << 2;
+        constexpr unsigned kOpWriteFixed = 1u << 3;
+
+        std::string errno_text(int err) {
+            return std::strerror(err);
+        }
+
+#if TELEMETRY_HAVE_IO_URING
+        int sys_setup(unsigned entries, io_uring_params* params) {
+            return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+        }
+
+        int sys_enter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+            return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+        }
+
+        int sys_register(int fd, unsigned opcode, const void* arg, unsigned count) {
+            return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+        }
+
+        // Ring indices are shared with the kernel: read the other side's index with
+        // acquire, publish ours with release.
+        unsigned load_acquire(unsigned* p) noexcept {
+            return std::atomic_ref<unsigned>(*p).load(std::memory_order_acquire);
+        }
+
+        void store_release(unsigned* p, unsigned value) noexcept {
+            std::atomic_ref<unsigned>(*p).store(value, std::memory_order_release);
+        }
+
+        unsigned* ring_field(void* ring, std::uint32_t offset) noexcept {
+            return reinterpret_cast<unsigned*>(static_cast<char*>(ring) + offset);
+        }
+#endif
+
+    } // namespace
+
+    // ---- IoUring ----
+
+#if TELEMETRY_HAVE_IO_URING
+
+    IoUring::IoUring(unsigned entries) {
+        io_uring_params params{};
+        fd_ = sys_setup(std::max(entries, 1u), &params);
+        if (fd_ < 0) {
+            throw std::runtime_error("IoUring: io_uring_setup failed: " + errno_text(errno));
+        }
+        sq_entries_ = params.sq_entries;
+
+        sq_ring_bytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_bytes_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_ring_bytes_ = cq_ring_bytes_ = std::max(sq_ring_bytes_, cq_ring_bytes_);
+        }
+        sqes_bytes_ = params.sq_entries * sizeof(io_uring_sqe);
+
+        auto map = [&](std::size_t bytes, off_t offset) -> void* {
+            void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+            return p == MAP_FAILED ? nullptr : p;
+        };
+        sq_ring_ = map(sq_ring_bytes_, IORING_OFF_SQ_RING);
+        cq_ring_ = single_mmap ? sq_ring_ : map(cq_ring_bytes_, IORING_OFF_CQ_RING);
+        sqes_ = map(sqes_bytes_, IORING_OFF_SQES);
+        if (!sq_ring_ || !cq_ring_ || !sqes_) {
+            const int err = errno;
+            close_ring();
+            throw std::runtime_error("IoUring: mapping the rings failed: " + errno_text(err));
+        }
+
+        sq_head_ = ring_field(sq_ring_, params.sq_off.head);
+        sq_tail_ = ring_field(sq_ring_, params.sq_off.tail);
+        sq_mask_ = ring_field(sq_ring_, params.sq_off.ring_mask);
+        sq_array_ = ring_field(sq_ring_, params.sq_off.array);
+        cq_head_ = ring_field(cq_ring_, params.cq_off.head);
+        cq_tail_ = ring_field(cq_ring_, params.cq_off.tail);
+        cq_mask_ = ring_field(cq_ring_, params.cq_off.ring_mask);
+        cqes_ = static_cast<char*>(cq_ring_) + params.cq_off.cqes;
+
+        // IORING_REGISTER_PROBE arrived with READ/WRITE in 5.6; before that only
+        // the 5.1 requests (READ_FIXED/WRITE_FIXED among them) exist.
+        constexpr unsigned kProbeOps = 256;
+        std::vector<std::uint8_t> probe_bytes(sizeof(io_uring_probe) + kProbeOps * sizeof(io_uring_probe_op));
+        auto* probe = reinterpret_cast<io_uring_probe*>(probe_bytes.data());
+        if (sys_register(fd_, IORING_REGISTER_PROBE, probe, kProbeOps) < 0) {
+            ops_ = kOpReadFixed | kOpWriteFixed;
+            return;
+        }
+        for (unsigned i = 0; i < probe->ops_len; i++) {
+            if (!(probe->ops[i].flags & IO_URING_OP_SUPPORTED)) {
+                continue;
+            }
+            switch (probe->ops[i].op) {
+                case IORING_OP_READ: ops_ |= kOpRead; break;
+                case IORING_OP_WRITE: ops_ |= kOpWrite; break;
+                case IORING_OP_READ_FIXED: ops_ |= kOpReadFixed; break;
+                case IORING_OP_WRITE_FIXED: ops_ |= kOpWriteFixed; break;
+                default: break;
+            }
+        }
+    }
+
+    IoUring::~IoUring() {
+        // Closing the ring does not cancel requests; let them finish first.
+        while (in_flight_ > 0) {
+            Completion c;
+            if (poll(c)) {
+                continue;
+            }
+            if (sys_enter(fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                break;
+            }
+        }
+        close_ring();
+    }
+
+    void IoUring::close_ring() noexcept {
+        if (sqes_) {
+            ::munmap(sqes_, sqes_bytes_);
+        }
+        if (cq_ring_ && cq_ring_ != sq_ring_) {
+            ::munmap(cq_ring_, cq_ring_bytes_);
+        }
+        if (sq_ring_) {
+            ::munmap(sq_ring_, sq_ring_bytes_);
+        }
+        sqes_ = cq_ring_ = sq_ring_ = nullptr;
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    bool IoUring::register_buffers(std::span<const std::span<std::uint8_t>> buffers) {
+        std::vector<iovec> iov;
+        iov.reserve(buffers.size());
+        for (const auto& buffer : buffers) {
+            iov.push_back(iovec{buffer.data(), buffer.size()});
+        }
+        return sys_register(fd_, IORING_REGISTER_BUFFERS, iov.data(), static_cast<unsigned>(iov.size())) == 0;
+    }
+
+    bool IoUring::queue(std::uint8_t opcode, int fd, std::uint64_t addr, std::uint32_t size,
+                        std::uint64_t offset, std::uint64_t user_data, int buffer) {
+        // Only this process moves the tail; the kernel moves the head as it consumes
+        const unsigned tail = *sq_tail_;
+        if (tail - load_acquire(sq_head_) >= sq_entries_) {
+            return false;
+        }
+
+        const unsigned index = tail & *sq_mask_;
+        io_uring_sqe* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = opcode;
+        sqe->fd = fd;
+        sqe->addr = addr;
+        sqe->len = size;
+        sqe->off = offset;
+        sqe->user_data = user_data;
+        if (buffer >= 0) {
+            sqe->buf_index = static_cast<std::uint16_t>(buffer);
+        }
+        sq_array_[index] = index;
+        store_release(sq_tail_, tail + 1);
+        queued_++;
+        return true;
+    }
+
+    bool IoUring::read(int fd, std::uint8_t* data, std::uint32_t size, std::uint64_t offset,
+                       std::uint64_t user_data, int buffer) {
+        return queue(buffer >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ, fd,
+                     reinterpret_cast<std::uint64_t>(data), size, offset, user_data, buffer);
+    }
+
+    bool IoUring::write(int fd, const std::uint8_t* data, std::uint32_t size, std::uint64_t offset,
+                        std::uint64_t user_data, int buffer) {
+        return queue(buffer >= 0 ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE, fd,
+                     reinterpret_cast<std::uint64_t>(data), size, offset, user_data, buffer);
+    }
+
+    void IoUring::submit(unsigned wait_for) {
+        const unsigned flags = wait_for > 0 ? IORING_ENTER_GETEVENTS : 0;
+        do {
+            int submitted = sys_enter(fd_, queued_, wait_for, flags);
+            if (submitted < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw std::runtime_error("IoUring: io_uring_enter failed: " + errno_text(errno));
+            }
+            queued_ -= static_cast<unsigned>(submitted);
+            in_flight_ += static_cast<unsigned>(submitted);
+            if (submitted == 0 && queued_ > 0) {
+                throw std::runtime_error("IoUring: io_uring_enter accepted no requests");
+            }
+        } while (queued_ > 0);
+    }
+
+    bool IoUring::poll(Completion& out) noexcept {
+        const unsigned head = *cq_head_;
+        if (head == load_acquire(cq_tail_)) {
+            return false;
+        }
+        const io_uring_cqe* cqe = static_cast<const io_uring_cqe*>(cqes_) + (head & *cq_mask_);
+        out.user_data = cqe->user_data;
+        out.res = cqe->res;
+        store_release(cq_head_, head + 1);
+        in_flight_--;
+        return true;
+    }
+
+    IoUring::Completion IoUring::wait() {
+        if (in_flight_ == 0 && queued_ == 0) {
+            throw std::runtime_error("IoUring: wait() with no request in flight");
+        }
+        Completion c;
+        while (!poll(c)) {
+            submit(1);
+        }
+        return c;
+    }
+
+    bool IoUring::available() noexcept {
+        static const bool ok = [] {
+            try {
+                IoUring probe(1);
+                return probe.can_read(false) && probe.can_write(false);
+            } catch (const std::runtime_error&) {
+                return false;
+            }
+        }();
+        return ok;
+    }
+
+    bool IoUring::can_read(bool registered) const noexcept {
+        return (ops_ & (registered ? kOpReadFixed : kOpRead)) != 0;
+    }
+
+    bool IoUring::can_write(bool registered) const noexcept {
+        return (ops_ & (registered ? kOpWriteFixed : kOpWrite)) != 0;
+    }
+
+#else // !TELEMETRY_HAVE_IO_URING
+
+    IoUring::IoUring(unsigned) {
+        throw std::runtime_error("IoUring: not supported on this platform");
+    }
+
+    IoUring::~IoUring() = default;
+    void IoUring::close_ring() noexcept {}
+    bool IoUring::register_buffers(std::span<const std::span<std::uint8_t>>) { return false; }
+    bool IoUring::queue(std::uint8_t, int, std::uint64_t, std::uint32_t, std::uint64_t, std::uint64_t, int) { return false; }
+    bool IoUring::read(int, std::uint8_t*, std::uint32_t, std::uint64_t, std::uint64_t, int) { return false; }
+    bool IoUring::write(int, const std::uint8_t*, std::uint32_t, std::uint64_t, std::uint64_t, int) { return false; }
+    void IoUring::submit(unsigned) {}
+    bool IoUring::poll(Completion&) noexcept { return false; }
+    IoUring::Completion IoUring::wait() { throw std::runtime_error("IoUring: not supported on this platform"); }
+    bool IoUring::available() noexcept { return false; }
+    bool IoUring::can_read(bool) const noexcept { return false; }
+    bool IoUring::can_write(bool) const noexcept { return false; }
+
+#endif
+
+    // ---- UringReadAhead ----
+
+    UringReadAhead::UringReadAhead(const std::filesystem::path& path,
+                                   std::uint64_t end,
+                                   std::size_t chunk_bytes,
+                                   std::size_t buffers)
+        : end_(end),
+          chunk_bytes_(std::clamp<std::size_t>(chunk_bytes, 1, kMaxRequestBytes)),
+          ring_(static_cast<unsigned>(std::max<std::size_t>(buffers, 2))),
+          slots_(std::max<std::size_t>(buffers, 2)) {
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            throw std::runtime_error("UringReadAhead: failed to open " + path.string());
+        }
+        ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        std::vector<std::span<std::uint8_t>> registered;
+        for (auto& slot : slots_) {
+            slot.data.resize(chunk_bytes_);
+            registered.emplace_back(slot.data);
+        }
+        fixed_ = ring_.register_buffers(registered);
+        if (!ring_.can_read(fixed_)) {
+            ::close(fd_);
+            throw std::runtime_error(std::string("UringReadAhead: kernel lacks ") +
+                                     (fixed_ ? "IORING_OP_READ_FIXED" : "IORING_OP_READ (buffers not registered)"));
+        }
+    }
+
+    UringReadAhead::~UringReadAhead() {
+        drain();
+        ::close(fd_);
+    }
+
+    void UringReadAhead::drain() noexcept {
+        while (ring_.in_flight() > 0 || ring_.queued() > 0) {
+            try {
+                ring_.wait();
+            } catch (const std::runtime_error&) {
+                break;
+            }
+        }
+        for (auto& slot : slots_) {
+            slot.state = SlotState::Idle;
+        }
+    }
+
+    void UringReadAhead::start(std::uint64_t offset) {
+        // Reads for the old position must land before their slots are reused
+        drain();
+        head_ = 0;
+        holding_ = false;
+        read_offset_ = offset;
+        for (std::size_t i = 0; i < slots_.size(); i++) {
+            queue_read(i);
+        }
+        ring_.submit();
+    }
+
+    void UringReadAhead::queue_read(std::size_t i) {
+        Slot& slot = slots_[i];
+        const std::size_t want = static_cast<std::size_t>(
+            std::min<std::uint64_t>(chunk_bytes_, end_ - std::min(end_, read_offset_)));
+        if (want == 0) {
+            slot.state = SlotState::Idle;
+            return;
+        }
+        slot.state = SlotState::InFlight;
+        slot.offset = read_offset_;
+        slot.want = want;
+        slot.size = 0;
+        slot.error = 0;
+        read_offset_ += want;
+        queue_rest(i);
+    }
+
+    void UringReadAhead::queue_rest(std::size_t i) {
+        Slot& slot = slots_[i];
+        // The ring has an entry per slot, so this cannot overflow it
+        ring_.read(fd_, slot.data.data() + slot.size, static_cast<std::uint32_t>(slot.want - slot.size),
+                   slot.offset + slot.size, i, fixed_ ? static_cast<int>(i) : -1);
+    }
+
+    void UringReadAhead::complete(const IoUring::Completion& c) {
+        const std::size_t i = static_cast<std::size_t>(c.user_data);
+        Slot& slot = slots_[i];
+        if (c.res < 0) {
+            if (c.res == -EINTR || c.res == -EAGAIN) {
+                queue_rest(i);
+                return;
+            }
+            slot.error = -c.res;
+            slot.state = SlotState::Ready;
+            return;
+        }
+
+        slot.size += static_cast<std::size_t>(c.res);
+        if (c.res == 0 || slot.size == slot.want) {
+            slot.state = SlotState::Ready; // complete, or cut short by EOF
+        } else {
+            queue_rest(i);
+        }
+    }
+
+    std::span<const std::uint8_t> UringReadAhead::next() {
+        // The chunk handed out last time is done with: read the next one into it
+        if (holding_) {
+            holding_ = false;
+            queue_read(held_);
+        }
+
+        Slot& slot = slots_[head_];
+        IoUring::Completion c;
+        while (ring_.poll(c)) {
+            complete(c);
+        }
+        if (ring_.queued() > 0) {
+            ring_.submit();
+        }
+        while (slot.state == SlotState::InFlight) {
+            complete(ring_.wait());
+        }
+
+        if (slot.state == SlotState::Idle) {
+            return {}; // nothing left before end_
+        }
+        if (slot.error != 0) {
+            throw std::runtime_error("UringReadAhead: read failed: " + errno_text(slot.error));
+        }
+        if (slot.size == 0) {
+            return {}; // EOF before end_
+        }
+
+        slot.state = SlotState::Held;
+        held_ = head_;
+        holding_ = true;
+        head_ = (head_ + 1) % slots_.size();
+        return {slot.data.data(), slot.size};
+    }
+
+    // ---- UringWriter ----
+
+    UringWriter::UringWriter(const std::filesystem::path& path,
+                             std::uint64_t offset,
+                             std::size_t buffer_bytes,
+                             std::size_t buffers)
+        : ring_(static_cast<unsigned>(std::max<std::size_t>(buffers, 2))),
+          slots_(std::max<std::size_t>(buffers, 2)),
+          offset_(offset) {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            throw std::runtime_error("UringWriter: failed to open " + path.string());
+        }
+
+        const std::size_t bytes = std::clamp<std::size_t>(buffer_bytes, 4096, kMaxRequestBytes);
+        std::vector<std::span<std::uint8_t>> registered;
+        for (auto& slot : slots_) {
+            slot.data.resize(bytes);
+            registered.emplace_back(slot.data);
+        }
+        fixed_ = ring_.register_buffers(registered);
+        if (!ring_.can_write(fixed_)) {
+            ::close(fd_);
+            throw std::runtime_error(std::string("UringWriter: kernel lacks ") +
+                                     (fixed_ ? "IORING_OP_WRITE_FIXED" : "IORING_OP_WRITE (buffers not registered)"));
+        }
+    }
+
+    UringWriter::~UringWriter() {
+        while (ring_.in_flight() > 0 || ring_.queued() > 0) {
+            try {
+                ring_.wait();
+            } catch (const std::runtime_error&) {
+                break;
+            }
+        }
+        ::close(fd_);
+    }
+
+    void UringWriter::write(std::span<const std::uint8_t> bytes) {
+        if (error_ != 0) {
+            throw std::runtime_error("UringWriter: write failed: " + errno_text(error_));
+        }
+
+        while (!bytes.empty()) {
+            Slot& slot = slots_[current_];
+            const std::size_t n = std::min(bytes.size(), slot.data.size() - fill_);
+            std::memcpy(slot.data.data() + fill_, bytes.data(), n);
+            fill_ += n;
+            bytes = bytes.subspan(n);
+            if (fill_ == slot.data.size()) {
+                queue_current();
+            }
+        }
+
+        // One io_uring_enter for every buffer filled by this call
+        if (ring_.queued() > 0) {
+            ring_.submit();
+        }
+    }
+
+    void UringWriter::queue_current() {
+        Slot& slot = slots_[current_];
+        slot.busy = true;
+        slot.offset = offset_;
+        slot.size = fill_;
+        slot.done = 0;
+        queue_rest(current_);
+
+        offset_ += fill_;
+        fill_ = 0;
+        current_ = (current_ + 1) % slots_.size();
+        while (slots_[current_].busy) {
+            reap();
+        }
+    }
+
+    void UringWriter::queue_rest(std::size_t i) {
+        Slot& slot = slots_[i];
+        ring_.write(fd_, slot.data.data() + slot.done, static_cast<std::uint32_t>(slot.size - slot.done),
+                    slot.offset + slot.done, i, fixed_ ? static_cast<int>(i) : -1);
+    }
+
+    void UringWriter::reap() {
+        const IoUring::Completion c = ring_.wait();
+        const std::size_t i = static_cast<std::size_t>(c.user_data);
+        Slot& slot = slots_[i];
+        if (c.res == -EINTR || c.res == -EAGAIN) {
+            queue_rest(i);
+            return;
+        }
+        if (c.res <= 0) {
+            slot.busy = false;
+            if (error_ == 0) {
+                error_ = c.res < 0 ? -c.res : EIO;
+            }
+            throw std::runtime_error("UringWriter: write failed: " + errno_text(error_));
+        }
+
+        slot.done += static_cast<std::size_t>(c.res);
+        if (slot.done < slot.size) {
+            queue_rest(i); // short write
+        } else {
+            slot.busy = false;
+        }
+    }
+
+    void UringWriter::flush() {
+        if (error_ != 0) {
+            throw std::runtime_error("UringWriter: write failed: " + errno_text(error_));
+        }
+        if (fill_ > 0) {
+            queue_current();
+        }
+        while (std::any_of(slots_.begin(), slots_.end(), [](const Slot& s) { return s.busy; })) {
+            reap();
+        }
+    }
+
+} // namespace telemetry
@@ -1,48 +1,256 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <ctime>
 #include <iomanip>
+#include <thread>
 
 #include "telemetry/Logger.h"
 
 namespace telemetry {
 
-    std::string Logger::make_timestamp() const {
-        auto now = std::chrono::system_clock::now();
-        std::time_t t = std::chrono::system_clock::to_time_t(now);
-        std::tm tm = *std::localtime(&t);
+    // Bounded multi-producer / single-consumer ring (per-slot sequence numbers).
+    //
+    // A producer claims a slot with one CAS on tail_, fills it and publishes it by
+    // bumping the slot's sequence; no locks on the caller side. Slot strings keep
+    // their capacity across laps, so steady-state logging does not allocate.
+    // Producers never notify: an idle writer polls with a backoff (1 ms up to 32 ms),
+    // so the caller-side cost stays a few atomics. flush(), shutdown and a full ring
+    // with OverflowPolicy::Block wake it immediately.
+    //
+    // The writer thread is the only one that touches owner_.file while the queue
+    // exists; flush() asks it to flush the file rather than doing it directly.
+    class Logger::AsyncQueue {
+        public:
+            AsyncQueue(Logger& owner, Options opt)
+                : owner_(owner),
+                  overflow_(opt.overflow) {
+                std::size_t capacity = 2;
+                while (capacity < opt.queue_capacity) {
+                    capacity <<= 1;
+                }
+                mask_ = capacity - 1;
+                slots_ = std::make_unique<Slot[]>(capacity);
+                for (std::size_t i = 0; i < capacity; i++) {
+                    slots_[i].sequence.store(i, std::memory_order_relaxed);
+                    slots_[i].message.reserve(kReservedMessageBytes);
+                }
+                writer_ = std::thread([this] { writer_loop(); });
+            }
+
+            ~AsyncQueue() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    stopping_ = true;
+                }
+                wake_.notify_one();
+                writer_.join();
+            }
+
+            void push(LogLevel level, const std::string& message) {
+                std::size_t pos = tail_.load(std::memory_order_relaxed);
+                Slot* slot = nullptr;
+                while (true) {
+                    slot = &slots_[pos & mask_];
+                    std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+                    auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+                    if (diff == 0) {
+                        if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else if (diff < 0) {
+                        // Full: the writer has not released this slot from the previous lap
+                        if (overflow_ == OverflowPolicy::Drop) {
+                            dropped_.fetch_add(1, std::memory_order_relaxed);
+                            return;
+                        }
+                        wake_writer();
+                        std::this_thread::yield();
+                        pos = tail_.load(std::memory_order_relaxed);
+                    } else {
+                        pos = tail_.load(std::memory_order_relaxed);
+                    }
+                }
+
+                slot->level = level;
+                slot->time = std::chrono::system_clock::now();
+                slot->message.assign(message);
+                slot->sequence.store(pos + 1, std::memory_order_release);
+            }
+
+            // Waits until every entry claimed before the call has been written and
+            // the writer thread has flushed the file after writing it.
+            void flush() {
+                std::size_t target = tail_.load(std::memory_order_acquire);
+                std::unique_lock<std::mutex> lock(mutex_);
+                flush_target_ = std::max(flush_target_, target);
+                wake_.notify_one();
+                drained_.wait(lock, [&] { return flushed_ >= target; });
+            }
+
+            std::uint64_t dropped() const {
+                return dropped_.load(std::memory_order_relaxed);
+            }
+
+        private:
+            struct Slot {
+                std::atomic<std::size_t> sequence{0};
+                LogLevel level = LogLevel::Info;
+                std::chrono::system_clock::time_point time;
+                std::string message;
+            };
+
+            // Writes are batched: one file write per this many bytes (or when the ring runs dry)
+            static constexpr std::size_t kBatchBytes = 64 * 1024;
+            static constexpr std::size_t kReservedMessageBytes = 128; // typical line fits without allocating
+            static constexpr std::chrono::milliseconds kMinIdleWait{1};
+            static constexpr std::chrono::milliseconds kMaxIdleWait{32};
+
+            Logger& owner_;
+            OverflowPolicy overflow_;
+            std::unique_ptr<Slot[]> slots_;
+            std::size_t mask_ = 0;
+
+            alignas(64) std::atomic<std::size_t> tail_{0};   // next slot to claim (producers)
+            alignas(64) std::size_t head_ = 0;               // next slot to read (writer only)
+            std::atomic<std::uint64_t> dropped_{0};
+
+            std::mutex mutex_;
+            std::condition_variable wake_;     // producers -> writer
+            std::condition_variable drained_;  // writer -> flush()
+            bool stopping_ = false;
+            std::size_t written_ = 0;          // guarded by mutex_
+            std::size_t flush_target_ = 0;     // flush() wants entries up to here flushed (mutex_)
+            std::size_t flushed_ = 0;          // entries written before the last file flush (mutex_)
+            std::thread writer_;
+
+            bool ready() const {
+                return slots_[head_ & mask_].sequence.load(std::memory_order_acquire) == head_ + 1;
+            }
+
+            void wake_writer() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                }
+                wake_.notify_one();
+            }
+
+            // Caller holds mutex_. True if a flush() waits for entries already written.
+            bool flush_due() const {
+                return flush_target_ > flushed_ && written_ >= flush_target_;
+            }
+
+            // Writer thread: flushes the file for waiting flush() calls.
+            void flush_file() {
+                owner_.file.flush();
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    flushed_ = head_;
+                }
+                drained_.notify_all();
+            }
+
+            void writer_loop() {
+                std::string batch;
+                std::string timestamp;
+                std::time_t timestamp_second = -1;
+                auto idle_wait = kMinIdleWait;
+
+                while (true) {
+                    // ---- Format a batch of published entries ----
+                    while (batch.size() < kBatchBytes && ready()) {
+                        Slot& slot = slots_[head_ & mask_];
+
+                        // localtime + put_time once per second, not once per line
+                        std::time_t second = std::chrono::system_clock::to_time_t(slot.time);
+                        if (second != timestamp_second) {
+                            timestamp = make_timestamp(slot.time);
+                            timestamp_second = second;
+                        }
+                        batch += '[';
+                        batch += to_string(slot.level);
+                        batch += "] ";
+                        batch += timestamp;
+                        batch += ' ';
+                        batch += slot.message;
+                        batch += '\n';
+
+                        slot.sequence.store(head_ + mask_ + 1, std::memory_order_release);
+                        head_++;
+                    }
+
+                    if (!batch.empty()) {
+                        owner_.file << batch;
+                        if (owner_.mirror_to_console_) {
+                            std::cout << batch;
+                        }
+                        batch.clear();
+                        bool flush_now;
+                        {
+                            std::lock_guard<std::mutex> lock(mutex_);
+                            written_ = head_;
+                            flush_now = flush_due();
+                        }
+                        drained_.notify_all();
+                        if (flush_now) {
+                            flush_file();
+                        }
+                        idle_wait = kMinIdleWait;
+                        continue;
+                    }
+
+                    // ---- Ring is empty: poll again later, or sooner if woken ----
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    if (!wake_.wait_for(lock, idle_wait, [&] { return stopping_ || ready() || flush_due(); })) {
+                        idle_wait = std::min(idle_wait * 2, kMaxIdleWait);
+                        continue;
+                    }
+                    if (flush_due()) {
+                        lock.unlock();
+                        flush_file();
+                        continue;
+                    }
+                    if (stopping_ && !ready()) {
+                        // Producers are gone (destructor): everything published has been written
+                        break;
+                    }
+                }
+                owner_.file.flush();
+            }
+    };
+
+    std::string Logger::make_timestamp(std::chrono::system_clock::time_point when) {
+        std::time_t t = std::chrono::system_clock::to_time_t(when);
+        std::tm tm{};
+        localtime_r(&t, &tm);
 
         std::ostringstream ts;
         ts << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
         std::string timestamp = ts.str();
-        
-        return timestamp;
-    }
-
-    int Logger::severity(LogLevel level) {
-        switch (level) {
-            case LogLevel::Info: return 0;
-            case LogLevel::Warn: return 1;
-            case LogLevel::Error: return 2;
-        }
-
-        return -1;
 
+        return timestamp;
     }
 
     void Logger::log(const std::string& message, LogLevel level) {
-        
-        if (severity(level) < severity(min_level)) {
+
+        if (!enabled(level)) {
             return;
         }
 
-        if (!file.is_open()) {
+        if (async_) {
+            async_->push(level, message);
             return;
         }
 
-        std::string timestamp = make_timestamp();
+        std::lock_guard<std::mutex> lock(mutex_);
+        write_line(level, make_timestamp(std::chrono::system_clock::now()), message);
+    }
+
+    void Logger::write_line(LogLevel level, const std::string& timestamp, const std::string& message) {
         std::ostringstream oss;
         oss << "[" << to_string(level) << "] " << timestamp << " " << message << "\n";
         std::string line = oss.str();
@@ -52,7 +260,11 @@ namespace telemetry {
         }
     }
 
-    Logger::Logger(const std::string& filename, LogLevel minLevel, bool mirrorToConsole) 
+    Logger::Logger(const std::string& filename, LogLevel minLevel, bool mirrorToConsole)
+        : Logger(filename, minLevel, mirrorToConsole, Options{})
+        {}
+
+    Logger::Logger(const std::string& filename, LogLevel minLevel, bool mirrorToConsole, Options opt)
 
     : file(filename, std::ios::app),
       min_level(minLevel),
@@ -61,10 +273,23 @@ namespace telemetry {
     {
         if (!file.is_open()) {
             std::cerr << "Failed to open file!\n";
+            return;
+        }
+
+        if (opt.async) {
+            async_ = std::make_unique<AsyncQueue>(*this, opt);
         }
     }
 
     Logger::~Logger() {
+        std::uint64_t dropped = dropped_messages();
+        async_.reset(); // drains the queue and joins the writer thread
+
+        if (dropped != 0) {
+            write_line(LogLevel::Warn, make_timestamp(std::chrono::system_clock::now()),
+                       "Logger dropped " + std::to_string(dropped) + " messages (queue full)");
+        }
+
         if (file.is_open()) {
             file.close();
         }
@@ -82,6 +307,19 @@ namespace telemetry {
         log(message, LogLevel::Error);
     }
 
+    void Logger::flush() {
+        if (async_) {
+            async_->flush(); // the writer thread owns the file
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        file.flush();
+    }
+
+    std::uint64_t Logger::dropped_messages() const {
+        return async_ ? async_->dropped() : 0;
+    }
+
     const char* Logger::to_string(LogLevel level) {
         switch (level) {
             case LogLevel::Info: return "INFO";
@@ -93,4 +331,4 @@ namespace telemetry {
 
     }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,214 @@
+#include <array>
+#include <bit>
+#include <cstring>
+
+#include "telemetry/Lz.h"
+
+namespace telemetry {
+
+    namespace {
+
+        constexpr std::size_t kMinMatch = 4;
+        constexpr std::size_t kMaxOffset = 65535;
+        constexpr unsigned kHashBits = 13;
+
+        // Matches stop this far from the end, so the match-extension loop can
+        // read 8 bytes at a time without bounds checks.
+        constexpr std::size_t kEndMargin = 8;
+
+        std::uint32_t load32(const std::uint8_t* p) noexcept {
+            std::uint32_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        std::uint64_t load64(const std::uint8_t* p) noexcept {
+            std::uint64_t v;
+            std::memcpy(&v, p, sizeof(v));
+            return v;
+        }
+
+        std::uint32_t hash4(std::uint32_t v) noexcept {
+            return (v * 2654435761u) >> (32 - kHashBits);
+        }
+
+        // Appends the 255-run extension of a length whose nibble was 15.
+        std::uint8_t* put_length(std::uint8_t* op, std::size_t rest) noexcept {
+            for (; rest >= 255; rest -= 255) {
+                *op++ = 255;
+            }
+            *op++ = static_cast<std::uint8_t>(rest);
+            return op;
+        }
+
+        // Appends one sequence; match_len == 0 means literals only (the last sequence).
+        // Returns nullptr if it would overrun oend.
+        std::uint8_t* put_sequence(std::uint8_t* op, std::uint8_t* oend,
+                                   const std::uint8_t* literals, std::size_t literal_len,
+                                   std::size_t offset, std::size_t match_len) noexcept {
+            const std::size_t worst = 1 + literal_len / 255 + 1 + literal_len + 2 + match_len / 255 + 1;
+            if (static_cast<std::size_t>(oend - op) < worst) {
+                return nullptr;
+            }
+
+            std::uint8_t* token = op++;
+            std::uint8_t nibbles = 0;
+            if (literal_len >= 15) {
+                nibbles = 15 << 4;
+                op = put_length(op, literal_len - 15);
+            } else {
+                nibbles = static_cast<std::uint8_t>(literal_len << 4);
+            }
+            if (literal_len != 0) {   // literals is null for empty input
+                std::memcpy(op, literals, literal_len);
+                op += literal_len;
+            }
+
+            if (match_len != 0) {
+                *op++ = static_cast<std::uint8_t>(offset & 0xFF);
+                *op++ = static_cast<std::uint8_t>(offset >> 8);
+                const std::size_t code = match_len - kMinMatch;
+                if (code >= 15) {
+                    nibbles |= 15;
+                    op = put_length(op, code - 15);
+                } else {
+                    nibbles |= static_cast<std::uint8_t>(code);
+                }
+            }
+            *token = nibbles;
+            return op;
+        }
+
+        // Reads a 255-run length extension. Returns false if src runs out.
+        bool get_length(const std::uint8_t*& ip, const std::uint8_t* iend, std::size_t& length) noexcept {
+            std::uint8_t byte;
+            do {
+                if (ip == iend) {
+                    return false;
+                }
+                byte = *ip++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        }
+
+    } // namespace
+
+    std::size_t lz_compress(std::span<const std::uint8_t> src, std::span<std::uint8_t> dst) noexcept {
+        const std::uint8_t* const base = src.data();
+        const std::uint8_t* const iend = base + src.size();
+        const std::uint8_t* ip = base;
+        const std::uint8_t* anchor = base;
+        std::uint8_t* op = dst.data();
+        std::uint8_t* const oend = dst.data() + dst.size();
+
+        if (src.size() > kMinMatch + kEndMargin) {
+            std::array<std::uint32_t, std::size_t{1} << kHashBits> table{};
+            const std::uint8_t* const match_limit = iend - kEndMargin;
+
+            while (ip + kMinMatch <= match_limit) {
+                const std::uint32_t v = load32(ip);
+                const std::uint32_t h = hash4(v);
+                const std::uint8_t* ref = base + table[h];
+                table[h] = static_cast<std::uint32_t>(ip - base);
+
+                if (ref >= ip || static_cast<std::size_t>(ip - ref) > kMaxOffset || load32(ref) != v) {
+                    // Step faster through data that does not match (incompressible runs)
+                    ip += 1 + (static_cast<std::size_t>(ip - anchor) >> 6);
+                    continue;
+                }
+
+                // Extend 8 bytes at a time, then finish on the first differing byte
+                std::size_t len = kMinMatch;
+                while (ip + len + 8 <= match_limit) {
+                    const std::uint64_t diff = load64(ip + len) ^ load64(ref + len);
+                    if (diff != 0) {
+                        const int bits = std::endian::native == std::endian::little
+                            ? std::countr_zero(diff) : std::countl_zero(diff);
+                        len += static_cast<std::size_t>(bits) / 8;
+                        goto matched;
+                    }
+                    len += 8;
+                }
+                while (ip + len < match_limit && ip[len] == ref[len]) {
+                    len++;
+                }
+            matched:
+                op = put_sequence(op, oend, anchor, static_cast<std::size_t>(ip - anchor),
+                                  static_cast<std::size_t>(ip - ref), len);
+                if (op == nullptr) {
+                    return 0;
+                }
+                ip += len;
+                anchor = ip;
+            }
+        }
+
+        op = put_sequence(op, oend, anchor, static_cast<std::size_t>(iend - anchor), 0, 0);
+        return op == nullptr ? 0 : static_cast<std::size_t>(op - dst.data());
+    }
+
+    bool lz_decompress(std::span<const std::uint8_t> src, std::span<std::uint8_t> dst) noexcept {
+        const std::uint8_t* ip = src.data();
+        const std::uint8_t* const iend = ip + src.size();
+        std::uint8_t* op = dst.data();
+        std::uint8_t* const ostart = op;
+        std::uint8_t* const oend = op + dst.size();
+
+        while (ip < iend) {
+            const std::uint8_t token = *ip++;
+
+            std::size_t literal_len = token >> 4;
+            if (literal_len == 15 && !get_length(ip, iend, literal_len)) {
+                return false;
+            }
+            if (literal_len > static_cast<std::size_t>(iend - ip) ||
+                literal_len > static_cast<std::size_t>(oend - op)) {
+                return false;
+            }
+            if (literal_len != 0) {   // op is null for an empty dst
+                std::memcpy(op, ip, literal_len);
+                ip += literal_len;
+                op += literal_len;
+            }
+
+            if (ip == iend) {
+                break; // last sequence: literals only
+            }
+
+            if (iend - ip < 2) {
+                return false;
+            }
+            const std::size_t offset = static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8);
+            ip += 2;
+            std::size_t match_len = token & 0x0F;
+            if (match_len == 15 && !get_length(ip, iend, match_len)) {
+                return false;
+            }
+            match_len += kMinMatch;
+
+            if (offset == 0 || offset > static_cast<std::size_t>(op - ostart) ||
+                match_len > static_cast<std::size_t>(oend - op)) {
+                return false;
+            }
+
+            const std::uint8_t* ref = op - offset;
+            if (offset >= 8 && static_cast<std::size_t>(oend - op) >= match_len + 8) {
+                // Non-overlapping 8-byte steps; may write up to 7 bytes past the match,
+                // which the next sequence overwrites
+                for (std::size_t i = 0; i < match_len; i += 8) {
+                    std::memcpy(op + i, ref + i, 8);
+                }
+            } else {
+                // Overlapping match (e.g. a run): byte by byte
+                for (std::size_t i = 0; i < match_len; i++) {
+                    op[i] = ref[i];
+                }
+            }
+            op += match_len;
+        }
+
+        return op == oend;
+    }
+
+} // namespace telemetry
@@ -0,0 +1,69 @@
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "telemetry/MappedFile.h"
+
+namespace telemetry {
+
+    MappedFile MappedFile::open(const std::filesystem::path& path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("MappedFile: failed to open " + path.string());
+        }
+
+        struct stat st{};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("MappedFile: failed to stat " + path.string());
+        }
+
+        std::size_t size = static_cast<std::size_t>(st.st_size);
+        if (size == 0) {
+            ::close(fd);
+            return MappedFile();
+        }
+
+        void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // the mapping keeps the file referenced
+        if (addr == MAP_FAILED) {
+            throw std::runtime_error("MappedFile: failed to map " + path.string());
+        }
+
+        // Replay is a forward scan: ask the kernel for aggressive read-ahead.
+        ::madvise(addr, size, MADV_SEQUENTIAL);
+
+        return MappedFile(static_cast<const std::uint8_t*>(addr), size);
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0))
+        {}
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    MappedFile::~MappedFile() {
+        release();
+    }
+
+    void MappedFile::release() noexcept {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<std::uint8_t*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+} // namespace telemetry
@@ -0,0 +1,108 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "telemetry/MappedTelemetryReader.h"
+#include "telemetry/RecordFraming.h"
+#include "telemetry/TelemetryFormat.h"
+
+namespace telemetry {
+
+    MappedTelemetryReader::MappedTelemetryReader(MappedFile file,
+                                                 std::uint16_t version,
+                                                 std::uint16_t flags,
+                                                 Options opt,
+                                                 telemetry::Logger& logger)
+        : file_(std::move(file)),
+          offset_(format::kHeaderSize),
+          data_end_(file_.size()),
+          version_(version),
+          flags_(flags),
+          opt_(std::move(opt)),
+          logger_(logger),
+          blocks_((flags & format::kFlagBlockCompressed) != 0)
+        {}
+
+    MappedTelemetryReader MappedTelemetryReader::open(const std::filesystem::path& path,
+                                                      telemetry::Logger& logger) {
+        return MappedTelemetryReader::open(path, Options{}, logger);
+    }
+
+    MappedTelemetryReader MappedTelemetryReader::open(const std::filesystem::path& path,
+                                                      Options opt,
+                                                      telemetry::Logger& logger) {
+        MappedFile file;
+        try {
+            file = MappedFile::open(path);
+        } catch (const std::runtime_error&) {
+            logger.error("MappedTelemetryReader failed to map file: " + path.string());
+            throw ParseError("failed to open telemetry file");
+        }
+
+        logger.info("MappedTelemetryReader mapped file: " + path.string() +
+                    " (" + std::to_string(file.size()) + " bytes)");
+
+        FileHeader header;
+        try {
+            header = parse_header(file.bytes());
+        } catch (const ParseError& e) {
+            logger.error(std::string("MappedTelemetryReader invalid header: ") + e.what());
+            throw;
+        }
+
+        logger.info("MappedTelemetryReader header OK | version=" +
+            std::to_string(header.version) +
+            " | flags=" +
+            std::to_string(header.flags));
+
+        MappedTelemetryReader reader(std::move(file), header.version, header.flags, opt, logger);
+        if (header.flags & format::kFlagIndexed) {
+            IndexTrailer trailer;
+            std::vector<IndexEntry> entries;
+            reader.data_end_ = load_index_footer(reader.file_.bytes(), trailer, entries);
+            if (reader.data_end_ == reader.file_.size()) {
+                logger.warn("MappedTelemetryReader index footer missing or invalid; reading to EOF");
+            }
+        }
+        return reader;
+    }
+
+    bool MappedTelemetryReader::next(std::span<const std::uint8_t>& out_packet) {
+        RecordView record;
+        try {
+            if (blocks_) {
+                while (block_pos_ >= block_.size()) {
+                    BlockView block;
+                    if (!frame_block(file_.bytes().first(data_end_).subspan(offset_), opt_.max_packet_size, block)) {
+                        logger_.info("MappedTelemetryReader reached clean EOF");
+                        return false;
+                    }
+                    decode_block(block, block_);
+                    block_pos_ = 0;
+                    offset_ += block.block_bytes;
+                }
+                frame_record(std::span<const std::uint8_t>(block_).subspan(block_pos_), opt_.max_packet_size, record);
+            } else if (!frame_record(file_.bytes().first(data_end_).subspan(offset_), opt_.max_packet_size, record)) {
+                logger_.info("MappedTelemetryReader reached clean EOF");
+                return false;
+            }
+        } catch (const ParseError& e) {
+            logger_.error("MappedTelemetryReader at offset " + std::to_string(offset_) + ": " + e.what());
+            throw;
+        }
+
+        if (!record_crc_ok(record)) {
+            logger_.error("MappedTelemetryReader CRC mismatch at offset " + std::to_string(offset_));
+            throw ParseError("incorrect CRC");
+        }
+
+        if (blocks_) {
+            block_pos_ += record.record_bytes;
+        } else {
+            offset_ += record.record_bytes;
+        }
+        out_packet = record.payload;
+        return true;
+    }
+
+} // namespace telemetry
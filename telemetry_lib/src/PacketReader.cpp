@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <bit>
 #include <format>
 #include <cstring>
@@ -6,29 +7,18 @@
 
 namespace telemetry {
 
-    PacketReader::PacketReader(std::span<const std::uint8_t> buffer,
-                              Endianness endianness) noexcept 
-                : buffer_(buffer),
-                  endianness_(endianness)
-                {}
-
-    std::uint8_t PacketReader::read_u8() {
-        if (empty()) {
-            throw std::out_of_range("no remaining bytes to read");
-        }
-        std::uint8_t byte = buffer_[0];
-        buffer_ = buffer_.subspan(1);
-        return byte;
+    void PacketReaderBase::throw_exhausted() {
+        throw std::out_of_range("no remaining bytes to read");
     }
 
-    void PacketReader::read_bytes(std::span<std::uint8_t> dst) {
+    void PacketReaderBase::read_bytes(std::span<std::uint8_t> dst) {
         if (dst.size() > remaining()) {
             throw std::out_of_range(
                 std::format("trying to read {} bytes, but only {} bytes available",
                             dst.size(), remaining())
             );
         }
-        
+
         if (dst.empty()) {
             return;
         }
@@ -37,72 +27,66 @@ namespace telemetry {
         buffer_ = buffer_.subspan(dst.size());
     }
 
-    std::uint16_t PacketReader::read_u16() {
-        std::uint8_t b0 = read_u8();
-        std::uint8_t b1 = read_u8();
-
-        if (endianness_ == Endianness::Big) {
-            return (static_cast<std::uint16_t>(b0) << 8) |
-                    static_cast<std::uint16_t>(b1);
+    void PacketReaderBase::skip(std::size_t count) {
+        if (count > remaining()) {
+            throw std::out_of_range(
+                std::format("trying to skip {} bytes, but only {} bytes available",
+                            count, remaining())
+            );
         }
 
-        // Little endian
-        return static_cast<std::uint16_t>(b0) |
-            (static_cast<std::uint16_t>(b1) << 8);
+        buffer_ = buffer_.subspan(count);
     }
 
-    std::uint32_t PacketReader::read_u32() {
-        std::uint16_t b01 = read_u16();
-        std::uint16_t b23 = read_u16();
-
-        if (endianness_ == PacketReader::Endianness::Big) {
-            return (static_cast<std::uint32_t>(b01) << 16) | static_cast<std::uint32_t>(b23);
-        } else {
-            // Little Endian
-            return static_cast<std::uint32_t>(b01) | (static_cast<std::uint32_t>(b23) << 16);
+    std::optional<std::uint64_t> PacketReaderBase::try_read_varint() noexcept {
+        std::uint64_t value = 0;
+        const std::size_t limit = std::min(buffer_.size(), kMaxVarintBytes);
+        for (std::size_t i = 0; i < limit; i++) {
+            const std::uint8_t byte = buffer_[i];
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << (7 * i);
+            if ((byte & 0x80) == 0) {
+                // The 10th byte only has room for the top bit of a u64
+                if (i == kMaxVarintBytes - 1 && byte > 1) {
+                    return std::nullopt;
+                }
+                buffer_ = buffer_.subspan(i + 1);
+                return value;
+            }
         }
+        return std::nullopt;
     }
 
-    std::uint64_t PacketReader::read_u64() {
-        std::uint32_t b0123 = read_u32();
-        std::uint32_t b4567 = read_u32();
-
-        if (endianness_ == PacketReader::Endianness::Big) {
-            return (static_cast<std::uint64_t>(b0123) << 32) | static_cast<std::uint64_t>(b4567);
-        } else {
-            // Little Endian
-            return static_cast<std::uint64_t>(b0123) | (static_cast<std::uint64_t>(b4567) << 32);
+    std::uint64_t PacketReaderBase::read_varint() {
+        if (auto value = try_read_varint()) [[likely]] {
+            return *value;
         }
+        if (remaining() < kMaxVarintBytes) {
+            throw_exhausted();
+        }
+        throw std::out_of_range("malformed varint (longer than 10 bytes)");
     }
 
-    float PacketReader::read_float() {
-        // A float is stored as 4 bytes (1 sign bit, 23 for mantissa, 8 for exponent)
-        return std::bit_cast<float>(read_u32());
-    }
-
+    PacketReader::PacketReader(std::span<const std::uint8_t> buffer,
+                              Endianness endianness) noexcept
+                : PacketReaderBase(buffer),
+                  swap_((endianness == Endianness::Big) != (std::endian::native == std::endian::big))
+                {}
 
-    [[nodiscard]] bool PacketReader::empty() const noexcept {
-        return remaining() == 0;
+    std::uint16_t PacketReader::read_u16() {
+        return load<std::uint16_t>(swap_);
     }
 
-    [[nodiscard]] std::size_t PacketReader::remaining() const noexcept {
-        return buffer_.size();
+    std::uint32_t PacketReader::read_u32() {
+        return load<std::uint32_t>(swap_);
     }
 
-    void PacketReader::skip(std::size_t count) {
-        if (count > remaining()) {
-            throw std::out_of_range(
-                std::format("trying to skip {} bytes, but only {} bytes available",
-                            count, remaining())
-            );
-        }
-
-        buffer_ = buffer_.subspan(count);
+    std::uint64_t PacketReader::read_u64() {
+        return load<std::uint64_t>(swap_);
     }
 
-
-    void PacketReader::clear() noexcept {
-        buffer_ = std::span<const uint8_t> {};
+    float PacketReader::read_float() {
+        // A float is stored as 4 bytes (1 sign bit, 23 for mantissa, 8 for exponent)
+        return load<float>(swap_);
     }
-    
-} // namespace telemetry 
\ No newline at end of file
+
+} // namespace telemetry
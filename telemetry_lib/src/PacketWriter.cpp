@@ -1,92 +1,222 @@
+#include <algorithm>
 #include <bit>
+#include <stdexcept>
+#include <utility>
 
 #include "telemetry/PacketWriter.h"
 
 namespace telemetry {
 
-    PacketWriter::PacketWriter(PacketWriter::Endianness endianness)
-        :endianness_(endianness){}
-
-    PacketWriter::~PacketWriter() = default;
+    namespace {
+        // First allocation: room for a typical frame without regrowing
+        constexpr std::size_t kInitialCapacity = 64;
 
-    PacketWriter& PacketWriter::add_u8(std::uint8_t byte) {
-        buffer_.push_back(byte);
-        return *this;
+        bool needs_swap(PacketWriter::Endianness endianness) {
+            return (endianness == PacketWriter::Endianness::Big) != (std::endian::native == std::endian::big);
+        }
     }
 
-    PacketWriter& PacketWriter::add_u16(std::uint16_t value) {
-        if (endianness_ == PacketWriter::Endianness::Big) {
-            add_u8(static_cast<uint8_t>((value >> 8) & 0xFF));
-            add_u8(static_cast<uint8_t>(value & 0xFF));
-        } else {
-            add_u8(static_cast<uint8_t>(value & 0xFF));
-            add_u8(static_cast<uint8_t>((value >> 8) & 0xFF));
+    std::span<std::uint8_t> PacketArena::allocate(std::size_t n) noexcept {
+        if (n > remaining()) {
+            return {};
         }
-        return *this;
+        auto out = storage_.subspan(used_, n);
+        used_ += n;
+        return out;
     }
 
-    PacketWriter& PacketWriter::add_u32(std::uint32_t value) {
-        if (endianness_ == PacketWriter::Endianness::Big) {
-            add_u16(static_cast<uint16_t>((value >> 16) & 0xFFFF));
-            add_u16(static_cast<uint16_t>(value & 0xFFFF));
-        } else {
-            add_u16(static_cast<uint16_t>(value & 0xFFFF));
-            add_u16(static_cast<uint16_t>((value >> 16) & 0xFFFF));
+    PacketWriterBase::PacketWriterBase(std::span<std::uint8_t> storage) noexcept
+        :data_(storage.data()),
+         capacity_(storage.size()),
+         owning_(false){}
 
+    PacketWriterBase::PacketWriterBase(PacketArena& arena) noexcept
+        :PacketWriterBase(arena.storage_.subspan(arena.used_)) {
+        arena_ = &arena;
+        arena_offset_ = arena.used_;
+    }
+
+    PacketWriterBase::~PacketWriterBase() = default;
+
+    PacketWriterBase::PacketWriterBase(PacketWriterBase&& other) noexcept
+        :buffer_(std::move(other.buffer_)),
+         data_(other.data_),
+         capacity_(other.capacity_),
+         size_(other.size_),
+         owning_(other.owning_),
+         overflowed_(other.overflowed_),
+         arena_(other.arena_),
+         arena_offset_(other.arena_offset_) {
+        // The moved-from writer keeps its mode but no storage
+        other.data_ = nullptr;
+        other.capacity_ = 0;
+        other.size_ = 0;
+        other.arena_ = nullptr;
+    }
+
+    PacketWriterBase& PacketWriterBase::operator=(PacketWriterBase&& other) noexcept {
+        if (this != &other) {
+            buffer_ = std::move(other.buffer_);
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            size_ = other.size_;
+            owning_ = other.owning_;
+            overflowed_ = other.overflowed_;
+            arena_ = other.arena_;
+            arena_offset_ = other.arena_offset_;
+            other.data_ = nullptr;
+            other.capacity_ = 0;
+            other.size_ = 0;
+            other.arena_ = nullptr;
         }
         return *this;
     }
 
-    PacketWriter& PacketWriter::add_u64(std::uint64_t value) {
-        if (endianness_ == PacketWriter::Endianness::Big) {
-            add_u32(static_cast<uint32_t>((value >> 32) & 0xFFFFFFFF));
-            add_u32(static_cast<uint32_t>(value & 0xFFFFFFFF));
-        } else {
-            add_u32(static_cast<uint32_t>(value & 0xFFFFFFFF));
-            add_u32(static_cast<uint32_t>((value >> 32) & 0xFFFFFFFF));
+    std::uint8_t* PacketWriterBase::grow(std::size_t n) {
+        if (capacity_ - size_ < n || overflowed_) {
+            // Sticky: after one skipped write nothing else is appended, so the
+            // bytes never contain a hole
+            if (!owning_ || overflowed_) {
+                overflowed_ = true;
+                return nullptr;
+            }
+            buffer_.resize(std::max({kInitialCapacity, buffer_.size() * 2, size_ + n}));
+            data_ = buffer_.data();
+            capacity_ = buffer_.size();
         }
+        if (arena_ != nullptr) {
+            // Someone else allocated behind this packet: it can no longer grow in place
+            if (arena_->used_ != arena_offset_ + size_) {
+                overflowed_ = true;
+                return nullptr;
+            }
+            arena_->used_ += n;
+        }
+        std::uint8_t* out = data_ + size_;
+        size_ += n;
+        return out;
+    }
 
-        return *this;
-}
-
-    PacketWriter& PacketWriter::add_bytes(std::span<const uint8_t> bytes)  {
-        buffer_.reserve(buffer_.size() + bytes.size());
-        buffer_.insert(buffer_.end(), bytes.begin(), bytes.end());     
-        return *this;
+    void PacketWriterBase::put_bytes(std::span<const uint8_t> bytes)  {
+        if (bytes.empty()) {
+            return;
+        }
+        if (std::uint8_t* out = grow(bytes.size())) {
+            std::memcpy(out, bytes.data(), bytes.size());
+        }
     }
 
-    PacketWriter& PacketWriter::add_string(std::string_view s) {
+    void PacketWriterBase::put_string(std::string_view s, bool swap) {
         if (s.size() > 65535) {
             throw std::length_error("string too long for u16 length prefix");
         }
 
-        add_u16(static_cast<std::uint16_t>(s.size()));
+        // Prefix + body fit together or not at all
+        if (!owning_ && capacity_ - size_ < sizeof(std::uint16_t) + s.size()) {
+            overflowed_ = true;
+            return;
+        }
+
+        put(static_cast<std::uint16_t>(s.size()), swap);
 
         auto ptr = reinterpret_cast<const std::uint8_t*>(s.data());
-        add_bytes(std::span<const std::uint8_t>(ptr, s.size()));
+        put_bytes(std::span<const std::uint8_t>(ptr, s.size()));
+    }
+
+    void PacketWriterBase::put_varint(std::uint64_t value) {
+        std::array<std::uint8_t, kMaxVarintBytes> encoded;
+        std::size_t n = 0;
+        while (value >= 0x80) {
+            encoded[n++] = static_cast<std::uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        encoded[n++] = static_cast<std::uint8_t>(value);
+
+        if (std::uint8_t* out = grow(n)) {
+            std::memcpy(out, encoded.data(), n);
+        }
+    }
+
+    void PacketWriterBase::clear() {
+        // An arena packet gives its bytes back only if it is still the arena's tail
+        if (arena_ != nullptr && arena_->used_ == arena_offset_ + size_) {
+            arena_->used_ = arena_offset_;
+        }
+        size_ = 0;
+        overflowed_ = false;
+    }
 
+    std::size_t PacketWriterBase::size() const {
+        return size_;
+    }
+
+    std::span<const std::uint8_t> PacketWriterBase::bytes() const {
+        return std::span<const std::uint8_t>(data_, size_);
+    }
+
+    void PacketWriterBase::reserve(std::size_t n) {
+        if (owning_ && n > buffer_.size()) {
+            buffer_.resize(n);
+            data_ = buffer_.data();
+            capacity_ = buffer_.size();
+        }
+    }
+
+    PacketWriter::PacketWriter(PacketWriter::Endianness endianness)
+        :swap_(needs_swap(endianness)){}
+
+    PacketWriter::PacketWriter(std::span<std::uint8_t> storage, PacketWriter::Endianness endianness) noexcept
+        :PacketWriterBase(storage),
+         swap_(needs_swap(endianness)){}
+
+    PacketWriter::PacketWriter(PacketArena& arena, PacketWriter::Endianness endianness) noexcept
+        :PacketWriterBase(arena),
+         swap_(needs_swap(endianness)){}
+
+    PacketWriter::~PacketWriter() = default;
+
+    PacketWriter& PacketWriter::add_u8(std::uint8_t byte) {
+        put(byte, swap_);
         return *this;
     }
 
-    PacketWriter& PacketWriter::add_float(float ft) {
-        uint32_t bits = std::bit_cast<uint32_t>(ft);
-        add_u32(bits);
+    PacketWriter& PacketWriter::add_u16(std::uint16_t value) {
+        put(value, swap_);
         return *this;
     }
 
-    void PacketWriter::clear() {
-        buffer_.clear();
+    PacketWriter& PacketWriter::add_u32(std::uint32_t value) {
+        put(value, swap_);
+        return *this;
     }
 
-    std::size_t PacketWriter::size() const {
-        return buffer_.size();
+    PacketWriter& PacketWriter::add_u64(std::uint64_t value) {
+        put(value, swap_);
+        return *this;
     }
 
-    std::span<const std::uint8_t> PacketWriter::bytes() const {
-        return std::span<const std::uint8_t>(buffer_.data(), buffer_.size());
+    PacketWriter& PacketWriter::add_bytes(std::span<const uint8_t> bytes)  {
+        put_bytes(bytes);
+        return *this;
     }
 
-    void PacketWriter::reserve(std::size_t n) {
-        buffer_.reserve(n);
+    PacketWriter& PacketWriter::add_string(std::string_view s) {
+        put_string(s, swap_);
+        return *this;
     }
-}
\ No newline at end of file
+
+    PacketWriter& PacketWriter::add_float(float ft) {
+        put(ft, swap_);
+        return *this;
+    }
+
+    PacketWriter& PacketWriter::add_varint(std::uint64_t value) {
+        put_varint(value);
+        return *this;
+    }
+
+    PacketWriter& PacketWriter::add_varint_signed(std::int64_t value) {
+        put_varint(zigzag_encode(value));
+        return *this;
+    }
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "telemetry/ReadAhead.h"
+
+namespace telemetry {
+
+    namespace {
+
+        // Reads until `size` bytes, EOF or an error. Returns the bytes read, or -1.
+        ssize_t pread_full(int fd, std::uint8_t* data, std::size_t size, std::uint64_t offset) {
+            std::size_t total = 0;
+            while (total < size) {
+                ssize_t got = ::pread(fd, data + total, size - total, static_cast<off_t>(offset + total));
+                if (got < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    return -1;
+                }
+                if (got == 0) {
+                    break;
+                }
+                total += static_cast<std::size_t>(got);
+            }
+            return static_cast<ssize_t>(total);
+        }
+
+    } // namespace
+
+    ReadAhead::ReadAhead(const std::filesystem::path& path,
+                         std::uint64_t end,
+                         std::size_t chunk_bytes,
+                         std::size_t buffers)
+        : end_(end),
+          chunk_bytes_(std::max<std::size_t>(chunk_bytes, 1)),
+          buffers_(std::max<std::size_t>(buffers, 2)),
+          sizes_(buffers_.size(), 0) {
+        fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd_ < 0) {
+            throw std::runtime_error("ReadAhead: failed to open " + path.string());
+        }
+        ::posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        for (auto& buffer : buffers_) {
+            buffer.resize(chunk_bytes_);
+        }
+        done_ = true; // idle until start()
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ReadAhead::~ReadAhead() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+        ::close(fd_);
+    }
+
+    void ReadAhead::start(std::uint64_t offset) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            generation_++;
+            head_ = 0;
+            count_ = 0;
+            holding_ = false;
+            read_offset_ = offset;
+            done_ = false;
+            error_.clear();
+        }
+        cv_.notify_all();
+    }
+
+    std::span<const std::uint8_t> ReadAhead::next() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (holding_) {
+            holding_ = false;
+            cv_.notify_all(); // the released slot can be refilled
+        }
+        cv_.wait(lock, [&] { return count_ > 0 || done_ || !error_.empty(); });
+        if (count_ == 0) {
+            if (!error_.empty()) {
+                throw std::runtime_error(error_);
+            }
+            return {};
+        }
+
+        const std::size_t slot = head_;
+        head_ = (head_ + 1) % buffers_.size();
+        count_--;
+        holding_ = true;
+        cv_.notify_all();
+        return {buffers_[slot].data(), sizes_[slot]};
+    }
+
+    void ReadAhead::run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [&] {
+                return stop_ || (!done_ && error_.empty() && count_ + (holding_ ? 1 : 0) < buffers_.size());
+            });
+            if (stop_) {
+                return;
+            }
+
+            // The slot after the filled ones is neither queued nor held by the consumer
+            const std::size_t slot = (head_ + count_) % buffers_.size();
+            const std::uint64_t offset = read_offset_;
+            const std::uint64_t generation = generation_;
+            const std::size_t want = static_cast<std::size_t>(
+                std::min<std::uint64_t>(chunk_bytes_, end_ - std::min(end_, offset)));
+
+            lock.unlock();
+            ssize_t got = want == 0 ? 0 : pread_full(fd_, buffers_[slot].data(), want, offset);
+            int read_errno = errno;
+            lock.lock();
+
+            if (generation != generation_) {
+                continue; // start() moved the reader while this chunk was in flight
+            }
+            if (got < 0) {
+                error_ = std::string("ReadAhead: read failed: ") + std::strerror(read_errno);
+            } else {
+                if (got > 0) {
+                    sizes_[slot] = static_cast<std::size_t>(got);
+                    count_++;
+                    read_offset_ += static_cast<std::uint64_t>(got);
+                }
+                if (static_cast<std::size_t>(got) < want || want == 0) {
+                    done_ = true;
+                }
+            }
+            cv_.notify_all();
+        }
+    }
+
+} // namespace telemetry
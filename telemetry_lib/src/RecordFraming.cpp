@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include "telemetry/RecordFraming.h"
+#include "telemetry/TelemetryFormat.h"
+#include "telemetry/CRC.h"
+#include "telemetry/Lz.h"
+
+namespace telemetry {
+
+    namespace {
+
+        std::uint16_t load_u16_le(const std::uint8_t* p) {
+            return static_cast<std::uint16_t>(p[0] | (p[1] << 8));
+        }
+
+        std::uint32_t load_u32_le(const std::uint8_t* p) {
+            return (static_cast<std::uint32_t>(p[3]) << 24) |
+                   (static_cast<std::uint32_t>(p[2]) << 16) |
+                   (static_cast<std::uint32_t>(p[1]) << 8) |
+                    static_cast<std::uint32_t>(p[0]);
+        }
+
+        std::uint64_t load_u64_le(const std::uint8_t* p) {
+            return static_cast<std::uint64_t>(load_u32_le(p)) |
+                  (static_cast<std::uint64_t>(load_u32_le(p + 4)) << 32);
+        }
+
+        void append_u32_le(std::vector<std::uint8_t>& out, std::uint32_t value) {
+            for (int i = 0; i < 4; i++) {
+                out.push_back(static_cast<std::uint8_t>((value >> (8 * i)) & 0xFF));
+            }
+        }
+
+        void append_u64_le(std::vector<std::uint8_t>& out, std::uint64_t value) {
+            append_u32_le(out, static_cast<std::uint32_t>(value & 0xFFFFFFFF));
+            append_u32_le(out, static_cast<std::uint32_t>(value >> 32));
+        }
+
+        // Mirrors the stream reader: a field that is missing entirely and a field
+        // that is cut short report different errors.
+        void require(std::size_t available, std::size_t needed, const char* missing_message) {
+            if (available >= needed) {
+                return;
+            }
+            if (available == 0) {
+                throw ParseError(missing_message);
+            }
+            throw ParseError("truncated input (unexpected EOF)");
+        }
+
+    }
+
+    FileHeader parse_header(std::span<const std::uint8_t> bytes) {
+        if (bytes.size() < format::kMagicSize) {
+            throw ParseError("truncated header (magic)");
+        }
+        if (!std::equal(format::kMagic.begin(), format::kMagic.end(), bytes.begin())) {
+            throw ParseError("invalid magic (expected 'TLRY')");
+        }
+        bytes = bytes.subspan(format::kMagicSize);
+
+        FileHeader header;
+        require(bytes.size(), format::kVersionSize, "unexpected EOF while reading u16");
+        header.version = load_u16_le(bytes.data());
+        bytes = bytes.subspan(format::kVersionSize);
+
+        require(bytes.size(), format::kFlagsSize, "unexpected EOF while reading u16");
+        header.flags = load_u16_le(bytes.data());
+
+        if (header.version != format::kCurrentVersion) {
+            throw ParseError("unsupported version");
+        }
+
+        return header;
+    }
+
+    bool frame_record(std::span<const std::uint8_t> bytes,
+                      std::size_t max_packet_size,
+                      RecordView& out) {
+        if (bytes.empty()) {
+            return false;
+        }
+
+        require(bytes.size(), format::kRecordSizeFieldBytes, "truncated input (unexpected EOF)");
+        std::uint32_t size = load_u32_le(bytes.data());
+
+        if (size == 0) {
+            throw ParseError("invalid packet size 0");
+        } else if (size > max_packet_size) {
+            throw ParseError("packet size " + std::to_string(size) + " exceeds max_packet_size");
+        }
+        if (size < format::CRC32_SIZE) {
+            throw ParseError("packet size too small for CRC");
+        }
+
+        auto rest = bytes.subspan(format::kRecordSizeFieldBytes);
+        require_record_bytes(size, rest.size());
+
+        std::size_t payload_size = size - format::CRC32_SIZE;
+        out.payload = rest.first(payload_size);
+        out.stored_crc = load_u32_le(rest.data() + payload_size);
+        out.record_bytes = format::kRecordSizeFieldBytes + size;
+
+        return true;
+    }
+
+    void require_record_bytes(std::uint32_t size, std::size_t available) {
+        std::size_t payload_size = size - format::CRC32_SIZE;
+        if (payload_size > 0) {
+            require(available, payload_size, "truncated packet payload");
+        }
+        require(available - payload_size, format::CRC32_SIZE, "unexpected EOF while reading u32");
+    }
+
+    bool record_crc_ok(const RecordView& record) {
+        return crc32(record.payload) == record.stored_crc;
+    }
+
+    std::size_t max_block_raw_size(std::size_t max_packet_size) noexcept {
+        return std::max(format::kMaxBlockBytes,
+                        max_packet_size + format::kRecordSizeFieldBytes + format::CRC32_SIZE);
+    }
+
+    std::uint32_t parse_block_header(std::span<const std::uint8_t> header,
+                                     std::size_t max_packet_size,
+                                     BlockView& out) {
+        const std::uint32_t stored_size = load_u32_le(header.data());
+        out.raw_size = load_u32_le(header.data() + 4);
+        out.stored_crc = load_u32_le(header.data() + 8);
+
+        if (out.raw_size == 0 || stored_size == 0 || stored_size > out.raw_size) {
+            throw ParseError("invalid block header");
+        }
+        if (out.raw_size > max_block_raw_size(max_packet_size)) {
+            throw ParseError("block size " + std::to_string(out.raw_size) + " exceeds limit");
+        }
+        out.block_bytes = format::kBlockHeaderSize + stored_size;
+        return stored_size;
+    }
+
+    bool frame_block(std::span<const std::uint8_t> bytes,
+                     std::size_t max_packet_size,
+                     BlockView& out) {
+        if (bytes.empty()) {
+            return false;
+        }
+        require(bytes.size(), format::kBlockHeaderSize, "truncated input (unexpected EOF)");
+        const std::uint32_t stored_size = parse_block_header(bytes.first(format::kBlockHeaderSize),
+                                                             max_packet_size, out);
+        auto rest = bytes.subspan(format::kBlockHeaderSize);
+        require(rest.size(), stored_size, "truncated block");
+        out.stored = rest.first(stored_size);
+        return true;
+    }
+
+    void decode_block(const BlockView& block, std::vector<std::uint8_t>& out) {
+        // Callers read records from out until its end, so a failed block leaves it
+        // empty: the next read starts over at the block header and fails again.
+        if (crc32(block.stored) != block.stored_crc) {
+            out.clear();
+            throw ParseError("incorrect block CRC");
+        }
+        out.resize(block.raw_size);
+        if (block.stored.size() == block.raw_size) {
+            std::memcpy(out.data(), block.stored.data(), block.raw_size);
+        } else if (!lz_decompress(block.stored, out)) {
+            out.clear();
+            throw ParseError("corrupt compressed block");
+        }
+    }
+
+    std::size_t append_block(std::vector<std::uint8_t>& out,
+                             std::span<const std::uint8_t> raw,
+                             std::vector<std::uint8_t>& scratch) {
+        scratch.resize(lz_compress_bound(raw.size()));
+        std::size_t compressed = lz_compress(raw, scratch);
+
+        // Equal sizes mean "stored", so compression has to save at least a byte
+        std::span<const std::uint8_t> stored = raw;
+        if (compressed != 0 && compressed < raw.size()) {
+            stored = std::span<const std::uint8_t>(scratch).first(compressed);
+        }
+
+        append_u32_le(out, static_cast<std::uint32_t>(stored.size()));
+        append_u32_le(out, static_cast<std::uint32_t>(raw.size()));
+        append_u32_le(out, crc32(stored));
+        out.insert(out.end(), stored.begin(), stored.end());
+        return format::kBlockHeaderSize + stored.size();
+    }
+
+    std::size_t IndexTrailer::footer_bytes() const noexcept {
+        return static_cast<std::size_t>(entry_count) * format::kIndexEntrySize + format::kIndexTrailerSize;
+    }
+
+    bool parse_index_trailer(std::span<const std::uint8_t> bytes, IndexTrailer& out) {
+        if (bytes.size() != format::kIndexTrailerSize) {
+            return false;
+        }
+        if (!std::equal(format::kIndexMagic.begin(), format::kIndexMagic.end(), bytes.begin() + 20)) {
+            return false;
+        }
+
+        out.record_count = load_u64_le(bytes.data());
+        out.entry_count = load_u32_le(bytes.data() + 8);
+        out.interval = load_u32_le(bytes.data() + 12);
+        out.footer_crc = load_u32_le(bytes.data() + 16);
+        if (out.interval == 0) {
+            return false;
+        }
+
+        // One entry per started interval: readers index entries by record / interval
+        const std::uint64_t entries = out.record_count / out.interval + (out.record_count % out.interval != 0);
+        return entries == out.entry_count;
+    }
+
+    bool parse_index_entries(std::span<const std::uint8_t> bytes,
+                             const IndexTrailer& trailer,
+                             std::uint64_t footer_start,
+                             std::vector<IndexEntry>& out) {
+        if (bytes.size() != static_cast<std::size_t>(trailer.entry_count) * format::kIndexEntrySize) {
+            return false;
+        }
+
+        std::vector<std::uint8_t> fields;
+        append_u64_le(fields, trailer.record_count);
+        append_u32_le(fields, trailer.entry_count);
+        append_u32_le(fields, trailer.interval);
+        if (Crc32().update(bytes).update(fields).value() != trailer.footer_crc) {
+            return false;
+        }
+
+        out.clear();
+        out.reserve(trailer.entry_count);
+        for (std::size_t i = 0; i < trailer.entry_count; i++) {
+            const std::uint8_t* p = bytes.data() + i * format::kIndexEntrySize;
+            IndexEntry entry{load_u64_le(p), load_u64_le(p + 8)};
+
+            // Records sit between the header and the footer, in file and time order
+            if (entry.record_offset < format::kHeaderSize || entry.record_offset >= footer_start ||
+                (!out.empty() && (entry.record_offset < out.back().record_offset ||
+                                  entry.timestamp_ms < out.back().timestamp_ms))) {
+                out.clear();
+                return false;
+            }
+            out.push_back(entry);
+        }
+        return true;
+    }
+
+    void append_index_footer(std::vector<std::uint8_t>& out,
+                             std::span<const IndexEntry> entries,
+                             std::uint64_t record_count,
+                             std::uint32_t interval) {
+        std::size_t entries_start = out.size();
+        for (const auto& entry : entries) {
+            append_u64_le(out, entry.record_offset);
+            append_u64_le(out, entry.timestamp_ms);
+        }
+        append_u64_le(out, record_count);
+        append_u32_le(out, static_cast<std::uint32_t>(entries.size()));
+        append_u32_le(out, interval);
+        append_u32_le(out, crc32(std::span<const std::uint8_t>(out).subspan(entries_start)));
+        out.insert(out.end(), format::kIndexMagic.begin(), format::kIndexMagic.end());
+    }
+
+    std::size_t load_index_footer(std::span<const std::uint8_t> file,
+                                  IndexTrailer& trailer,
+                                  std::vector<IndexEntry>& entries) {
+        entries.clear();
+        if (file.size() < format::kHeaderSize + format::kIndexTrailerSize ||
+            !parse_index_trailer(file.last(format::kIndexTrailerSize), trailer) ||
+            trailer.footer_bytes() > file.size() - format::kHeaderSize) {
+            return file.size();
+        }
+
+        std::size_t footer_start = file.size() - trailer.footer_bytes();
+        auto entry_bytes = file.subspan(footer_start, trailer.footer_bytes() - format::kIndexTrailerSize);
+        if (!parse_index_entries(entry_bytes, trailer, footer_start, entries)) {
+            entries.clear();
+            return file.size();
+        }
+        return footer_start;
+    }
+
+} // namespace telemetry
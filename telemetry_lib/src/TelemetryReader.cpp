@@ -1,8 +1,12 @@
 #include "telemetry/TelemetryReader.h"
 #include "telemetry/TelemetryFormat.h"
 #include "telemetry/CRC.h"
+#include "telemetry/IoUring.h"
+#include "telemetry/RecordFraming.h"
 
+#include <algorithm>
 #include <array>
+#include <limits>
 #include <vector>
 #include <span>
 #include <string>
@@ -20,7 +24,11 @@ namespace telemetry {
         version_(version),
         flags_(flags),
         opt_(std::move(opt)),
-        logger_(logger)
+        logger_(logger),
+        position_(format::kHeaderSize),
+        data_end_(std::numeric_limits<std::uint64_t>::max()),
+        buf_(std::max(opt_.read_block_bytes, opt_.max_packet_size + format::kRecordSizeFieldBytes + format::CRC32_SIZE)),
+        blocks_((flags & format::kFlagBlockCompressed) != 0)
         {}
 
         TelemetryReader TelemetryReader::open(const std::filesystem::path& path,
@@ -83,64 +91,397 @@ namespace telemetry {
 
         // 5) Construct and return TelemetryReader by moving the stream + storing version/flags/options.
         //    return TelemetryReader(std::move(in), version, flags, opt);
-        return TelemetryReader(std::move(in), version, flags, opt, logger);
+        TelemetryReader reader(std::move(in), version, flags, opt, logger);
+        if (flags & format::kFlagIndexed) {
+            reader.load_index(std::filesystem::file_size(path));
+        }
+        if (opt.read_ahead || opt.io_uring) {
+            reader.start_read_ahead(path);
+        }
+        return reader;
     }
 
-    bool TelemetryReader::read_next(std::vector<std::uint8_t>& out_packet) {
-        // Try to read the size of the next payload. Return false if EOF
-        std::array<std::uint8_t, format::kRecordSizeFieldBytes> packet_size{};
-        if (!read_exact(file_, std::span<std::uint8_t>(packet_size))) {
-            logger_.info("TelemetryReader reached clean EOF");
-            return false;
+    void TelemetryReader::load_index(std::uint64_t file_size) {
+        auto unindexed = [&](const char* why) {
+            logger_.warn(std::string("TelemetryReader index unavailable (") + why + "); reading unindexed");
+            file_.clear();
+            file_.seekg(static_cast<std::streamoff>(format::kHeaderSize));
+        };
+
+        if (file_size < format::kHeaderSize + format::kIndexTrailerSize) {
+            unindexed("file too small for footer");
+            return;
         }
-        // Able to read packet size (read_exact returns false only for clean EOF; otherwise it either fills the buffer or throws.)
-        // Validate packet size (using little endian)
-        uint32_t size = (static_cast<std::uint32_t>(packet_size[3])) << 24 | 
-                        (static_cast<std::uint32_t>(packet_size[2])) << 16 |
-                        (static_cast<std::uint32_t>(packet_size[1])) << 8 |
-                        (static_cast<std::uint32_t>(packet_size[0]));
-        
-        if (size == static_cast<std::uint32_t>(0)) {
-            logger_.error("TelemetryReader invalid packet size 0");
-            throw ParseError("invalid packet size 0");
-        } else if (size > opt_.max_packet_size) {
-            logger_.error("TelemetryReader packet size exceeds limit: " +
-                            std::to_string(size));
-            throw ParseError("packet size " + std::to_string(size) + " exceeds max_packet_size");
+
+        std::array<std::uint8_t, format::kIndexTrailerSize> trailer_bytes{};
+        file_.seekg(static_cast<std::streamoff>(file_size - format::kIndexTrailerSize));
+        IndexTrailer trailer;
+        if (!read_exact(file_, std::span<std::uint8_t>(trailer_bytes)) ||
+            !parse_index_trailer(trailer_bytes, trailer) ||
+            trailer.footer_bytes() > file_size - format::kHeaderSize) {
+            unindexed("missing or invalid trailer");
+            return;
         }
 
-        //Prepare out_packet for reading payload (minus CRC bits)
-        if (size < format::CRC32_SIZE) {
-            logger_.error("TelemetryReader packet size too small for CRC");
-            throw ParseError("packet size too small for CRC");
+        std::uint64_t footer_start = file_size - trailer.footer_bytes();
+        std::vector<std::uint8_t> entry_bytes(trailer.footer_bytes() - format::kIndexTrailerSize);
+        std::vector<IndexEntry> entries;
+        file_.seekg(static_cast<std::streamoff>(footer_start));
+        if (!read_exact(file_, std::span<std::uint8_t>(entry_bytes)) ||
+            !parse_index_entries(entry_bytes, trailer, footer_start, entries)) {
+            unindexed("corrupt entries");
+            return;
         }
-        out_packet.resize(size - format::CRC32_SIZE);
 
+        index_offsets_.reserve(entries.size());
+        index_timestamps_.reserve(entries.size());
+        for (const auto& entry : entries) {
+            index_offsets_.push_back(entry.record_offset);
+            index_timestamps_.push_back(entry.timestamp_ms);
+        }
+        indexed_ = true;
+        index_interval_ = trailer.interval;
+        index_record_count_ = trailer.record_count;
+        data_end_ = footer_start;
+
+        file_.clear();
+        file_.seekg(static_cast<std::streamoff>(format::kHeaderSize));
+
+        logger_.info("TelemetryReader loaded index | records=" + std::to_string(index_record_count_) +
+                     " | entries=" + std::to_string(entries.size()) +
+                     " | interval=" + std::to_string(index_interval_));
+    }
+
+    void TelemetryReader::start_read_ahead(const std::filesystem::path& path) {
+        const char* engine = "thread";
+        if (opt_.io_uring) {
+            try {
+                read_ahead_ = std::make_unique<UringReadAhead>(path, data_end_, opt_.read_block_bytes,
+                                                               opt_.read_ahead_buffers);
+                engine = "io_uring";
+            } catch (const std::runtime_error& e) {
+                logger_.warn(std::string("TelemetryReader io_uring unavailable (") + e.what() + ")");
+                if (!opt_.read_ahead) {
+                    return; // plain reads through file_
+                }
+            }
+        }
+        if (!read_ahead_) {
+            try {
+                read_ahead_ = std::make_unique<ReadAhead>(path, data_end_, opt_.read_block_bytes, opt_.read_ahead_buffers);
+            } catch (const std::runtime_error& e) {
+                logger_.error(std::string("TelemetryReader ") + e.what());
+                throw ParseError("failed to open telemetry file");
+            }
+        }
+        try {
+            read_ahead_->start(position_);
+        } catch (const std::runtime_error& e) {
+            logger_.error(std::string("TelemetryReader ") + e.what());
+            throw ParseError("failed to open telemetry file");
+        }
+        logger_.info(std::string("TelemetryReader read-ahead started | engine=") + engine +
+                     " | chunk=" + std::to_string(opt_.read_block_bytes) +
+                     " | buffers=" + std::to_string(opt_.read_ahead_buffers));
+    }
 
-        // Read payload into out_packet (read_exact will throw error if less than 'size' bytes are read)
-        if (!read_exact(file_, std::span<std::uint8_t>(out_packet))) {
-            logger_.error("TelemetryReader truncated packet payload");
-            out_packet.clear(); // Clear out_packet on failure to read payload
-            throw ParseError("truncated packet payload");
+    std::size_t TelemetryReader::fill(std::size_t need) {
+        std::size_t avail = buf_end_ - buf_pos_;
+        if (avail >= need || eof_) {
+            return avail;
         }
 
-        // Read the CRC bits and check against the actual CRC
-        std::uint32_t crc_computed = crc32(std::span<std::uint8_t>(out_packet)); // CRC Computed from packet payload
+        // Keep the unparsed tail (a record cut by the previous read) and refill behind it
+        if (buf_pos_ != 0) {
+            std::memmove(buf_.data(), buf_.data() + buf_pos_, avail);
+            buf_pos_ = 0;
+            buf_end_ = avail;
+        }
+        if (buf_.size() < need) {
+            buf_.resize(need);
+        }
 
-        uint32_t crc_stored = read_u32_le(file_); // CRC stored at the end of the payload
-        
-        
-        if (crc_computed != crc_stored) {
+        while (read_ahead_ && buf_end_ < need) {
+            // Chunks are already in memory: copy as much as fits
+            if (ahead_.empty()) {
+                try {
+                    ahead_ = read_ahead_->next();
+                } catch (const std::runtime_error& e) {
+                    logger_.error(std::string("TelemetryReader ") + e.what());
+                    throw ParseError("truncated input (unexpected EOF)");
+                }
+                if (ahead_.empty()) {
+                    eof_ = true;
+                    break;
+                }
+            }
+            std::size_t n = std::min(ahead_.size(), buf_.size() - buf_end_);
+            std::memcpy(buf_.data() + buf_end_, ahead_.data(), n);
+            ahead_ = ahead_.subspan(n);
+            buf_end_ += n;
+        }
+
+        while (!read_ahead_ && buf_end_ < need) {
+            // Never read into the index footer
+            std::size_t want = buf_.size() - buf_end_;
+            std::uint64_t file_pos = position_ + buf_end_;
+            if (data_end_ != std::numeric_limits<std::uint64_t>::max()) {
+                want = static_cast<std::size_t>(std::min<std::uint64_t>(want, data_end_ - std::min(data_end_, file_pos)));
+            }
+            if (want == 0) {
+                eof_ = true;
+                break;
+            }
+            file_.read(reinterpret_cast<char*>(buf_.data() + buf_end_), static_cast<std::streamsize>(want));
+            std::size_t got = static_cast<std::size_t>(file_.gcount());
+            buf_end_ += got;
+            if (got < want) {
+                eof_ = true;
+                break;
+            }
+        }
+        return buf_end_ - buf_pos_;
+    }
+
+    bool TelemetryReader::next_record(RecordView& out) {
+        std::size_t avail = fill(format::kRecordSizeFieldBytes);
+        if (avail >= format::kRecordSizeFieldBytes) {
+            const std::uint8_t* p = buf_.data() + buf_pos_;
+            std::size_t size = static_cast<std::size_t>(p[0]) | (static_cast<std::size_t>(p[1]) << 8) |
+                               (static_cast<std::size_t>(p[2]) << 16) | (static_cast<std::size_t>(p[3]) << 24);
+            // An oversized field is rejected by frame_record; don't buffer for it
+            if (size <= opt_.max_packet_size) {
+                avail = fill(format::kRecordSizeFieldBytes + size);
+            }
+        }
+
+        try {
+            if (!frame_record(std::span<const std::uint8_t>(buf_.data() + buf_pos_, avail), opt_.max_packet_size, out)) {
+                return false;
+            }
+        } catch (const ParseError& e) {
+            logger_.error(std::string("TelemetryReader ") + e.what());
+            throw;
+        }
+        buf_pos_ += out.record_bytes;
+        position_ += out.record_bytes;
+        return true;
+    }
+
+    bool TelemetryReader::load_block() {
+        std::size_t avail = fill(format::kBlockHeaderSize);
+        BlockView block;
+        try {
+            if (avail >= format::kBlockHeaderSize) {
+                std::uint32_t stored_size = parse_block_header(
+                    std::span<const std::uint8_t>(buf_.data() + buf_pos_, format::kBlockHeaderSize),
+                    opt_.max_packet_size, block);
+                avail = fill(format::kBlockHeaderSize + stored_size);
+            }
+            if (!frame_block(std::span<const std::uint8_t>(buf_.data() + buf_pos_, avail), opt_.max_packet_size, block)) {
+                return false;
+            }
+            decode_block(block, block_);
+        } catch (const ParseError& e) {
+            logger_.error(std::string("TelemetryReader ") + e.what());
+            throw;
+        }
+        block_pos_ = 0;
+        block_offset_ = position_;
+        buf_pos_ += block.block_bytes;
+        position_ += block.block_bytes;
+        return true;
+    }
+
+    bool TelemetryReader::next_block_record(RecordView& out) {
+        while (block_pos_ >= block_.size()) {
+            if (!load_block()) {
+                return false;
+            }
+        }
+        frame_record(std::span<const std::uint8_t>(block_).subspan(block_pos_), opt_.max_packet_size, out);
+        block_pos_ += out.record_bytes;
+        return true;
+    }
+
+    bool TelemetryReader::read_next(std::span<const std::uint8_t>& out_packet) {
+        RecordView record;
+        if (!(blocks_ ? next_block_record(record) : next_record(record))) {
+            logger_.info("TelemetryReader reached clean EOF");
+            return false;
+        }
+        if (!record_crc_ok(record)) {
             logger_.error("TelemetryReader CRC mismatch");
             throw ParseError("incorrect CRC");
         }
+        next_record_++;
+        out_packet = record.payload;
+        logger_.info("TelemetryReader read packet | payload={} bytes", out_packet.size());
+        return true;
+    }
 
-        logger_.info("TelemetryReader read packet | payload=" +
-                    std::to_string(out_packet.size()) +
-                    " bytes");
-        
+    bool TelemetryReader::read_next(std::vector<std::uint8_t>& out_packet) {
+        std::span<const std::uint8_t> payload;
+        if (!read_next(payload)) {
+            return false;
+        }
+        // assign, not resize + read: the payload is copied once, never zero-filled first
+        out_packet.assign(payload.begin(), payload.end());
         return true;
+    }
+
+    bool TelemetryReader::frame_next(RecordView& out, std::uint64_t& file_offset) {
+        if (blocks_) {
+            if (!next_block_record(out)) {
+                return false;
+            }
+            file_offset = block_offset_;
+            return true;
+        }
+        file_offset = position_;
+        return next_record(out);
+    }
+
+    void TelemetryReader::unread(const RecordView& record) noexcept {
+        if (blocks_) {
+            block_pos_ -= record.record_bytes;
+        } else {
+            buf_pos_ -= record.record_bytes;
+            position_ -= record.record_bytes;
+        }
+    }
+
+    PacketBatch TelemetryReader::read_batch(std::size_t max_records, std::size_t max_bytes) {
+        PacketBatch batch;
+        read_batch(batch, max_records, max_bytes);
+        return batch;
+    }
 
+    bool TelemetryReader::read_batch(PacketBatch& out, std::size_t max_records, std::size_t max_bytes) {
+        // An empty batch means EOF, so a request that can only return one is refused
+        if (max_records == 0) {
+            throw std::invalid_argument("TelemetryReader: read_batch needs max_records > 0");
+        }
+        out.clear(next_record_);
+        while (out.size() < max_records) {
+            RecordView record;
+            std::uint64_t file_offset = 0;
+            try {
+                if (!frame_next(record, file_offset)) {
+                    break;
+                }
+            } catch (const ParseError&) {
+                // Hand out the good records first; the next call reports the error
+                if (out.empty()) {
+                    throw;
+                }
+                break;
+            }
+
+            if (!out.empty() && out.payload_bytes() + record.payload.size() > max_bytes) {
+                unread(record);
+                break;
+            }
+            if (!record_crc_ok(record)) {
+                unread(record);
+                if (out.empty()) {
+                    logger_.error("TelemetryReader CRC mismatch");
+                    throw ParseError("incorrect CRC");
+                }
+                break;
+            }
+
+            out.append(record.payload, file_offset);
+            next_record_++;
+        }
+
+        if (out.empty()) {
+            logger_.info("TelemetryReader reached clean EOF");
+            return false;
+        }
+        logger_.info("TelemetryReader read batch | records={} | payload={} bytes", out.size(), out.payload_bytes());
+        return true;
+    }
+
+    void TelemetryReader::seek_to_offset(std::uint64_t offset, std::uint64_t record_number) {
+        next_record_ = record_number;
+        block_.clear();
+        block_pos_ = 0;
+
+        // Targets inside the buffered window (e.g. a rewind within the last read) need no I/O
+        const std::uint64_t window_start = position_ - buf_pos_;
+        if (offset >= window_start && offset <= position_ + (buf_end_ - buf_pos_)) {
+            buf_pos_ = static_cast<std::size_t>(offset - window_start);
+            position_ = offset;
+            return;
+        }
+
+        if (read_ahead_) {
+            read_ahead_->start(offset);
+            ahead_ = {};
+        } else {
+            file_.clear();
+            file_.seekg(static_cast<std::streamoff>(offset));
+        }
+        position_ = offset;
+        buf_pos_ = 0;
+        buf_end_ = 0;
+        eof_ = false;
+    }
+
+    bool TelemetryReader::seek_to_record(std::uint64_t n) {
+        if (indexed_) {
+            if (n >= index_record_count_) {
+                seek_to_offset(data_end_, index_record_count_);
+                return false;
+            }
+            std::uint64_t k = std::min<std::uint64_t>(n / index_interval_, index_offsets_.size() - 1);
+            seek_to_offset(index_offsets_[k], k * index_interval_);
+        } else if (n < next_record_) {
+            seek_to_offset(format::kHeaderSize, 0);
+        }
+
+        // Skip the remaining records by framing them only (no CRC work)
+        while (next_record_ < n) {
+            RecordView record;
+            if (!(blocks_ ? next_block_record(record) : next_record(record))) {
+                return false;
+            }
+            next_record_++;
+        }
+
+        bool buffered = blocks_ && block_pos_ < block_.size();
+        if (!indexed_ && !buffered && fill(1) == 0) {
+            return false;
+        }
+
+        logger_.info("TelemetryReader positioned at record " + std::to_string(n));
+        return true;
+    }
+
+    std::uint64_t TelemetryReader::seek_to_time(std::uint64_t ms) {
+        if (!indexed_) {
+            logger_.error("TelemetryReader seek_to_time on a file without index");
+            throw ParseError("recording has no time index");
+        }
+
+        // Index timestamps are non-decreasing: find the last entry before ms. Records
+        // between that entry and the next one may already be at ms (ties are common,
+        // untimestamped packets inherit the previous timestamp), so never start at
+        // an entry whose timestamp equals ms.
+        auto it = std::lower_bound(index_timestamps_.begin(), index_timestamps_.end(), ms);
+        std::uint64_t k = (it == index_timestamps_.begin())
+            ? 0 : static_cast<std::uint64_t>(it - index_timestamps_.begin() - 1);
+
+        if (index_offsets_.empty()) {
+            seek_to_offset(data_end_, 0);
+            return 0;
+        }
+
+        seek_to_offset(index_offsets_[k], k * index_interval_);
+        logger_.info("TelemetryReader seek_to_time " + std::to_string(ms) +
+                     "ms -> record " + std::to_string(next_record_));
+        return next_record_;
     }
 
     bool TelemetryReader::read_exact(std::istream& in, std::span<std::uint8_t> buf) {
@@ -170,16 +511,4 @@ namespace telemetry {
         return (static_cast<std::uint16_t>(u16Buffer[1]) << 8) | static_cast<std::uint16_t>(u16Buffer[0]);
     }
 
-    std::uint32_t TelemetryReader::read_u32_le(std::istream& in) {
-        std::array<std::uint8_t, 4> u32Buffer{};
-        if (!read_exact(in, std::span<std::uint8_t>(u32Buffer))) {
-            throw ParseError("unexpected EOF while reading u32");
-        }
-
-        return (static_cast<std::uint32_t>(u32Buffer[3])) << 24 | 
-                (static_cast<std::uint32_t>(u32Buffer[2])) << 16 |
-                (static_cast<std::uint32_t>(u32Buffer[1])) << 8 |
-                (static_cast<std::uint32_t>(u32Buffer[0]));
-    }
-
 }
\ No newline at end of file
@@ -1,26 +1,63 @@
 #include <stdexcept>
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <limits>
 #include <filesystem>
-#include <sstream>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 #include "telemetry/TelemetryRecorder.h"
 #include "telemetry/TelemetryFormat.h"
 #include "telemetry/CRC.h"
+#include "telemetry/MappedFile.h"
 
 // File format:
 // [TLRY][u16 version][u16 flags]
 // Repeated records: [u32 size][payload bytes...][u32 crc]
+// (block mode: repeated [u32 stored][u32 raw][u32 crc][LZ-compressed records])
 
 namespace telemetry {
 
     TelemetryRecorder::TelemetryRecorder(const std::filesystem::path& path,
                         telemetry::Logger& logger,
                         OpenMode mode = OpenMode::Truncate)
-        : logger_(logger)
+        : TelemetryRecorder(path, logger, mode, Options{})
+        {}
+
+    TelemetryRecorder::TelemetryRecorder(const std::filesystem::path& path,
+                        telemetry::Logger& logger,
+                        OpenMode mode,
+                        Options opt)
+        : path_(path),
+          logger_(logger),
+          opt_(opt),
+          payload_flags_(opt.payload_flags & format::kPayloadFlagsMask)
         {
 
+        // A dropped compact frame would break the delta chain of the frames after it
+        // and shift key frames off the indexed records. Refused before the file is touched.
+        if ((payload_flags_ & format::kFlagCompactFrames) && opt_.async &&
+            opt_.backpressure == Backpressure::Drop) {
+            logger_.error("TelemetryRecorder compact frames cannot use Backpressure::Drop: " + path.string());
+            throw std::invalid_argument("TelemetryRecorder: compact frames require Backpressure::Block");
+        }
+
         bool empty = !std::filesystem::exists(path) || std::filesystem::file_size(path) == 0;
+        bool write_header = mode == TelemetryRecorder::OpenMode::Truncate || empty;
+
+        block_limit_ = std::clamp<std::size_t>(opt_.block_bytes, 1, format::kMaxBlockBytes);
+
+        if (write_header) {
+            indexing_ = opt_.index_interval > 0;
+            index_interval_ = opt_.index_interval;
+            blocks_ = opt_.compress_blocks;
+            block_offset_ = format::kHeaderSize;
+        } else {
+            open_existing_for_append(path);
+        }
 
         if (mode == TelemetryRecorder::OpenMode::Append) {
             out_.open(path, std::ios::binary | std::ios::out | std::ios::app);
@@ -38,80 +75,573 @@ namespace telemetry {
         // Turn on fail and bad bits for error detection
         out_.exceptions(std::ios::failbit | std::ios::badbit);
 
+        // Writes continue at the current end (0 after truncation, the stripped
+        // footer's start when appending)
+        if (opt_.direct_io) {
+            try {
+                direct_ = std::make_unique<DirectWriter>(path, std::filesystem::file_size(path),
+                                                         opt_.direct_buffer_bytes);
+                logger_.info("TelemetryRecorder O_DIRECT writes | buffer=" +
+                             std::to_string(opt_.direct_buffer_bytes) + " bytes");
+            } catch (const std::runtime_error& e) {
+                logger_.warn(std::string("TelemetryRecorder O_DIRECT unavailable (") + e.what() +
+                             "); using buffered stream writes");
+            }
+            if (opt_.io_uring) {
+                logger_.warn("TelemetryRecorder io_uring ignored with direct_io");
+            }
+        } else if (opt_.io_uring) {
+            try {
+                uring_ = std::make_unique<UringWriter>(path, std::filesystem::file_size(path),
+                                                       opt_.io_uring_buffer_bytes, opt_.io_uring_buffers);
+                logger_.info("TelemetryRecorder io_uring writes | buffer=" +
+                             std::to_string(opt_.io_uring_buffer_bytes) + " bytes x" +
+                             std::to_string(opt_.io_uring_buffers));
+            } catch (const std::runtime_error& e) {
+                logger_.warn(std::string("TelemetryRecorder io_uring unavailable (") + e.what() +
+                             "); using buffered stream writes");
+            }
+        }
+
         // Write the header //
-        if (mode == TelemetryRecorder::OpenMode::Truncate || empty) {
+        if (write_header) {
 
             // 'Magic'
-            out_.write(reinterpret_cast<const char*>(format::kMagic.data()), static_cast<std::streamsize>(format::kMagicSize));
+            write_out(format::kMagic);
 
             // Version
             std::uint16_t version = format::kCurrentVersion;
-            out_.write(reinterpret_cast<const char*>(&version), sizeof(version));
+            write_out({reinterpret_cast<const std::uint8_t*>(&version), sizeof(version)});
 
             // Flags
-            std::uint16_t flags = 0;
-            out_.write(reinterpret_cast<const char*>(&flags), sizeof(flags));
+            std::uint16_t flags = this->flags();
+            write_out({reinterpret_cast<const std::uint8_t*>(&flags), sizeof(flags)});
 
+            next_offset_ = format::kHeaderSize;
             logger_.info("TelemetryRecorder wrote file header (magic/version/flags)");
         } else {
             logger_.info("TelemetryRecorder appending to existing file");
         }
 
+        if (opt_.async) {
+            front_.reserve(opt_.async_buffer_bytes);
+            back_.reserve(opt_.async_buffer_bytes);
+            writer_ = std::thread(&TelemetryRecorder::writer_loop, this);
+            logger_.info("TelemetryRecorder async mode | buffer=" +
+                         std::to_string(opt_.async_buffer_bytes) + " bytes x2 | backpressure=" +
+                         (opt_.backpressure == Backpressure::Block ? "block" : "drop"));
+        }
+
+    }
+
+    void TelemetryRecorder::open_existing_for_append(const std::filesystem::path& path) {
+        const std::uint64_t file_size = std::filesystem::file_size(path);
+        std::uint64_t data_end = file_size;
+        std::uint16_t flags = 0;
+        IndexTrailer trailer;
+        {
+            MappedFile existing;
+            try {
+                existing = MappedFile::open(path);
+            } catch (const std::runtime_error&) {
+                logger_.error("TelemetryRecorder failed to inspect existing file: " + path.string());
+                throw std::runtime_error("Telemetry Recorder: Failed to open file: " + path.string());
+            }
+
+            auto bytes = existing.bytes();
+            if (bytes.size() >= format::kHeaderSize) {
+                flags = static_cast<std::uint16_t>(bytes[6] | (bytes[7] << 8));
+            }
+            if (flags & format::kFlagIndexed) {
+                data_end = load_index_footer(bytes, trailer, index_);
+            }
+        }
+
+        if ((flags & format::kPayloadFlagsMask) != payload_flags_) {
+            logger_.error("TelemetryRecorder payload encoding does not match existing file: " + path.string());
+            throw std::runtime_error("Telemetry Recorder: payload flags do not match existing file: " + path.string());
+        }
+
+        next_offset_ = data_end;
+
+        // The file's record layout wins over the options
+        blocks_ = (flags & format::kFlagBlockCompressed) != 0;
+        block_offset_ = data_end;
+        if (blocks_ != opt_.compress_blocks) {
+            logger_.warn(std::string("TelemetryRecorder appending ") + (blocks_ ? "compressed blocks" : "plain records") +
+                         " to match the existing file");
+        }
+
+        if (!(flags & format::kFlagIndexed)) {
+            if (opt_.index_interval > 0) {
+                logger_.warn("TelemetryRecorder cannot index: existing file was recorded without an index");
+            }
+            return;
+        }
+
+        if (data_end == file_size) {
+            logger_.warn("TelemetryRecorder existing index footer missing or corrupt; appending unindexed");
+            return;
+        }
+
+        // Strip the footer; it is rewritten (with the new records) on close.
+        std::filesystem::resize_file(path, data_end);
+        indexing_ = true;
+        index_interval_ = trailer.interval;
+        record_count_ = trailer.record_count;
+        block_record_ = record_count_;
+        first_block_entry_ = index_.size();
+        if (!index_.empty()) {
+            last_timestamp_ = index_.back().timestamp_ms;
+        }
+        logger_.info("TelemetryRecorder continuing index | records=" + std::to_string(record_count_) +
+                     " | interval=" + std::to_string(index_interval_));
     }
 
     TelemetryRecorder::~TelemetryRecorder() {
+        stop_writer();
+        if (blocks_ && out_.is_open() && !writer_error_) {
+            try {
+                write_block();
+            } catch (const std::exception&) {
+                logger_.error("TelemetryRecorder failed to write final block");
+            }
+        }
+        if (indexing_ && out_.is_open() && !writer_error_) {
+            try {
+                write_index_footer();
+            } catch (const std::exception&) {
+                logger_.error("TelemetryRecorder failed to write index footer");
+            }
+        }
+        if (uring_ || direct_) {
+            try {
+                flush_out();
+            } catch (const std::exception&) {
+                logger_.error("TelemetryRecorder failed to complete pending writes");
+            }
+            uring_.reset();
+            direct_.reset();
+        }
         if (out_.is_open()) {
             logger_.info("TelemetryRecorder closing file");
-            out_.close();
+            try {
+                out_.close();
+            } catch (const std::ios_base::failure&) {
+                logger_.error("TelemetryRecorder close failed (I/O exception)");
+            }
         }
     }
 
-    void TelemetryRecorder::write_u32_le(std::uint32_t value) {
-        // Write using little endian
-        std::array<uint8_t, 4> bytes = {static_cast<std::uint8_t>(value & 0xFF), static_cast<std::uint8_t>((value >> 8) & 0xFF),
-                                        static_cast<std::uint8_t>((value >> 16) & 0xFF), static_cast<std::uint8_t>((value >> 24) & 0xFF)};
-        out_.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(4));
+    namespace {
+
+        void append_u32_le(std::vector<std::uint8_t>& buffer, std::uint32_t value) {
+            // Write using little endian
+            std::array<uint8_t, 4> bytes = {static_cast<std::uint8_t>(value & 0xFF), static_cast<std::uint8_t>((value >> 8) & 0xFF),
+                                            static_cast<std::uint8_t>((value >> 16) & 0xFF), static_cast<std::uint8_t>((value >> 24) & 0xFF)};
+            buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+        }
 
     }
 
-    void TelemetryRecorder::write_packet(std::span<const std::uint8_t> packet_bytes) {
+    std::size_t TelemetryRecorder::framed_size(std::span<const std::uint8_t> packet_bytes) {
 
-        // Calculate packet size (inlcuding CRC) and the CRC value itself
+        // Calculate packet size (inlcuding CRC)
         std::size_t size = packet_bytes.size() + format::CRC32_SIZE;
-        std::uint32_t crc = crc32(packet_bytes);
-        
+
         if (size > std::numeric_limits<std::uint32_t>::max()) {
             logger_.error("TelemetryRecorder packet size exceeds uint32_t limit");
             throw std::runtime_error("Packet size exceeds limits for uint32_t");
         }
 
-        try {
-            // Write the size of the payload
-            write_u32_le(static_cast<std::uint32_t>(size));
-            // Write the actual payload
-            out_.write(reinterpret_cast<const char*>(packet_bytes.data()), static_cast<std::streamsize>(packet_bytes.size()));
-            // Write the CRC at the end of the payload
-            write_u32_le(crc);
+        return format::kRecordSizeFieldBytes + size;
+    }
+
+    std::uint32_t TelemetryRecorder::append_record(std::vector<std::uint8_t>& buffer,
+                                                   std::span<const std::uint8_t> packet_bytes) {
+
+        std::size_t size = packet_bytes.size() + format::CRC32_SIZE;
+        std::uint32_t crc = crc32(packet_bytes);
 
-            std::ostringstream oss;
-            oss << std::hex << std::uppercase << crc;
-            logger_.info(
-                "TelemetryRecorder wrote packet | payload=" +
-                std::to_string(packet_bytes.size()) +
-                " bytes | crc=0x" + oss.str()
-            );
+        // Write the size of the payload
+        append_u32_le(buffer, static_cast<std::uint32_t>(size));
+        // Write the actual payload
+        buffer.insert(buffer.end(), packet_bytes.begin(), packet_bytes.end());
+        // Write the CRC at the end of the payload
+        append_u32_le(buffer, crc);
 
+        return crc;
+    }
 
+    void TelemetryRecorder::write_staging() {
+        try {
+            write_records(staging_);
         }
         catch (const std::ios_base::failure&) {
+            staging_.clear();
             logger_.error("TelemetryRecorder write failed (I/O exception)");
             throw std::runtime_error("TelemetryRecorder: write failed");
-        } 
+        }
+        stats_.bytes_written += staging_.size();
+        staging_.clear();
+    }
+
+    void TelemetryRecorder::write_out(std::span<const std::uint8_t> bytes) {
+        if (!uring_ && !direct_) {
+            out_.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            return;
+        }
+        try {
+            if (direct_) {
+                direct_->write(bytes);
+            } else {
+                uring_->write(bytes);
+            }
+        } catch (const std::runtime_error& e) {
+            logger_.error(std::string("TelemetryRecorder ") + e.what());
+            throw std::ios_base::failure(e.what());
+        }
+    }
+
+    void TelemetryRecorder::flush_out() {
+        if (!uring_ && !direct_) {
+            out_.flush();
+            return;
+        }
+        try {
+            if (direct_) {
+                direct_->flush();
+            } else {
+                uring_->flush();
+            }
+        } catch (const std::runtime_error& e) {
+            logger_.error(std::string("TelemetryRecorder ") + e.what());
+            throw std::ios_base::failure(e.what());
+        }
+    }
+
+    void TelemetryRecorder::write_records(std::span<const std::uint8_t> framed) {
+        if (!blocks_) {
+            write_out(framed);
+            return;
+        }
+
+        // Walk the size fields so blocks only ever hold whole records
+        std::size_t pos = 0;
+        while (pos < framed.size()) {
+            const std::uint8_t* p = framed.data() + pos;
+            const std::size_t record = format::kRecordSizeFieldBytes +
+                (static_cast<std::size_t>(p[0]) | (static_cast<std::size_t>(p[1]) << 8) |
+                 (static_cast<std::size_t>(p[2]) << 16) | (static_cast<std::size_t>(p[3]) << 24));
+
+            const bool index_start = indexing_ && block_record_ % index_interval_ == 0;
+            if (!block_.empty() && (block_.size() + record > block_limit_ || index_start)) {
+                write_block();
+            }
+            if (block_.empty() && index_start) {
+                block_index_offsets_.push_back(block_offset_);
+            }
+            block_.insert(block_.end(), p, p + record);
+            block_record_++;
+            pos += record;
+        }
+
+        if (block_.size() >= block_limit_) {
+            write_block();
+        }
+    }
+
+    void TelemetryRecorder::write_block() {
+        if (block_.empty()) {
+            return;
+        }
+        block_out_.clear();
+        block_offset_ += append_block(block_out_, block_, block_scratch_);
+        block_.clear();
+        write_out(block_out_);
+    }
+
+    void TelemetryRecorder::write_packet(std::span<const std::uint8_t> packet_bytes) {
+        write_single(packet_bytes, {});
+    }
+
+    void TelemetryRecorder::write_packet(std::span<const std::uint8_t> packet_bytes, std::uint64_t timestamp_ms) {
+        write_single(packet_bytes, std::span<const std::uint64_t>(&timestamp_ms, 1));
+    }
+
+    void TelemetryRecorder::write_packets(std::span<const std::span<const std::uint8_t>> packets) {
+        write_batch(packets, {});
+    }
+
+    void TelemetryRecorder::write_packets(std::span<const std::span<const std::uint8_t>> packets,
+                                          std::span<const std::uint64_t> timestamps_ms) {
+        if (timestamps_ms.size() != packets.size()) {
+            logger_.error("TelemetryRecorder write_packets timestamp count mismatch");
+            throw std::invalid_argument("TelemetryRecorder: one timestamp per packet required");
+        }
+        write_batch(packets, timestamps_ms);
+    }
+
+    void TelemetryRecorder::write_single(std::span<const std::uint8_t> packet_bytes,
+                                         std::span<const std::uint64_t> timestamp_ms) {
+
+        auto packets = std::span<const std::span<const std::uint8_t>>(&packet_bytes, 1);
+
+        if (opt_.async) {
+            if (!enqueue(packets, timestamp_ms)) {
+                return;
+            }
+            logger_.info("TelemetryRecorder queued packet | payload={} bytes", packet_bytes.size());
+            return;
+        }
+
+        staging_.clear();
+        staging_.reserve(framed_size(packet_bytes));
+        std::uint32_t crc = append_record(staging_, packet_bytes);
+        write_staging();
+        note_records(packets, timestamp_ms);
+
+        logger_.info("TelemetryRecorder wrote packet | payload={} bytes | crc=0x{:X}",
+                     packet_bytes.size(), crc);
+    }
+
+    void TelemetryRecorder::write_batch(std::span<const std::span<const std::uint8_t>> packets,
+                                        std::span<const std::uint64_t> timestamps_ms) {
+
+        if (packets.empty()) {
+            return;
+        }
+
+        if (opt_.async) {
+            if (enqueue(packets, timestamps_ms)) {
+                logger_.info("TelemetryRecorder queued batch | packets={}", packets.size());
+            }
+            return;
+        }
+
+        std::size_t total = 0;
+        for (const auto& packet : packets) {
+            total += framed_size(packet);
+        }
+
+        staging_.clear();
+        staging_.reserve(total);
+        for (const auto& packet : packets) {
+            append_record(staging_, packet);
+        }
+        write_staging();
+        note_records(packets, timestamps_ms);
+
+        logger_.info("TelemetryRecorder wrote batch | packets={} | bytes={}", packets.size(), total);
+    }
+
+    void TelemetryRecorder::note_records(std::span<const std::span<const std::uint8_t>> packets,
+                                         std::span<const std::uint64_t> timestamps_ms) {
+        for (std::size_t i = 0; i < packets.size(); i++) {
+            if (i < timestamps_ms.size()) {
+                if (timestamps_ms[i] < last_timestamp_) {
+                    logger_.warn("TelemetryRecorder timestamp went backwards ({} < {}); clamped for the index",
+                                 timestamps_ms[i], last_timestamp_);
+                } else {
+                    last_timestamp_ = timestamps_ms[i];
+                }
+            }
+            if (indexing_ && record_count_ % index_interval_ == 0) {
+                index_.push_back(IndexEntry{next_offset_, last_timestamp_});
+            }
+            record_count_++;
+            next_offset_ += format::kRecordSizeFieldBytes + packets[i].size() + format::CRC32_SIZE;
+        }
+    }
+
+    void TelemetryRecorder::write_index_footer() {
+        if (blocks_) {
+            // Entries recorded at accept time point at the blocks those records start
+            if (index_.size() - first_block_entry_ != block_index_offsets_.size()) {
+                logger_.error("TelemetryRecorder block index out of sync; dropping new index entries");
+                index_.resize(std::min(index_.size(), first_block_entry_ + block_index_offsets_.size()));
+            }
+            for (std::size_t i = first_block_entry_; i < index_.size(); i++) {
+                index_[i].record_offset = block_index_offsets_[i - first_block_entry_];
+            }
+        }
+        staging_.clear();
+        append_index_footer(staging_, index_, record_count_, index_interval_);
+        write_out(staging_);
+        staging_.clear();
+        logger_.info("TelemetryRecorder wrote index footer | records=" + std::to_string(record_count_) +
+                     " | entries=" + std::to_string(index_.size()));
+    }
+
+    bool TelemetryRecorder::enqueue(std::span<const std::span<const std::uint8_t>> packets,
+                                    std::span<const std::uint64_t> timestamps_ms) {
+
+        std::size_t total = 0;
+        for (const auto& packet : packets) {
+            total += framed_size(packet);
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        rethrow_writer_error();
+
+        // A batch larger than one buffer is still accepted once the front buffer is empty.
+        if (!front_.empty() && front_.size() + total > opt_.async_buffer_bytes) {
+            if (opt_.backpressure == Backpressure::Drop) {
+                stats_.dropped_packets += packets.size();
+                return false;
+            }
+
+            auto stall_start = std::chrono::steady_clock::now();
+            space_ready_.wait(lock, [&] {
+                return front_.empty() || front_.size() + total <= opt_.async_buffer_bytes || writer_error_;
+            });
+            stats_.stalls++;
+            stats_.stall_time += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - stall_start);
+            rethrow_writer_error();
+        }
+
+        for (const auto& packet : packets) {
+            append_record(front_, packet);
+        }
+        accepted_bytes_ += total;
+        note_records(packets, timestamps_ms);
+
+        std::size_t queued = static_cast<std::size_t>(accepted_bytes_ - written_bytes_);
+        if (queued > stats_.max_queued_bytes) {
+            stats_.max_queued_bytes = queued;
+        }
+
+        lock.unlock();
+        data_ready_.notify_one();
+        return true;
+    }
+
+    void TelemetryRecorder::writer_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            data_ready_.wait(lock, [&] { return stopping_ || !front_.empty(); });
+            if (front_.empty()) {
+                return; // stopping and fully drained
+            }
+
+            // Swap buffers: producers keep appending while the full one is written.
+            std::swap(front_, back_);
+            lock.unlock();
+            space_ready_.notify_all();
+
+            std::exception_ptr error;
+            {
+                std::lock_guard<std::mutex> io_lock(io_mutex_);
+                try {
+                    write_records(back_);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+
+            lock.lock();
+            written_bytes_ += back_.size();
+            stats_.bytes_written += back_.size();
+            back_.clear();
+            if (error && !writer_error_) {
+                writer_error_ = error;
+            }
+            written_.notify_all();
+            space_ready_.notify_all();
+        }
+    }
+
+    void TelemetryRecorder::stop_writer() {
+        if (!writer_.joinable()) {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        data_ready_.notify_one();
+        writer_.join();
+
+        if (writer_error_) {
+            logger_.error("TelemetryRecorder background write failed (I/O exception)");
+        }
+    }
+
+    void TelemetryRecorder::rethrow_writer_error() {
+        // Caller holds mutex_
+        if (writer_error_) {
+            logger_.error("TelemetryRecorder background write failed (I/O exception)");
+            throw std::runtime_error("TelemetryRecorder: write failed");
+        }
     }
 
     void TelemetryRecorder::flush() {
-        out_.flush();
-        logger_.info("TelemetryRecorder flushed output stream");
+        if (!opt_.async) {
+            try {
+                write_block();
+            } catch (const std::ios_base::failure&) {
+                logger_.error("TelemetryRecorder write failed (I/O exception)");
+                throw std::runtime_error("TelemetryRecorder: write failed");
+            }
+            try {
+                flush_out();
+            } catch (const std::ios_base::failure&) {
+                logger_.error("TelemetryRecorder flush failed (I/O exception)");
+                throw std::runtime_error("TelemetryRecorder: flush failed");
+            }
+            logger_.info("TelemetryRecorder flushed output stream");
+            return;
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            std::uint64_t target = accepted_bytes_;
+            written_.wait(lock, [&] { return written_bytes_ >= target || writer_error_; });
+            rethrow_writer_error();
+        }
+
+        {
+            std::lock_guard<std::mutex> io_lock(io_mutex_);
+            try {
+                write_block();
+                flush_out();
+            } catch (const std::ios_base::failure&) {
+                logger_.error("TelemetryRecorder flush failed (I/O exception)");
+                throw std::runtime_error("TelemetryRecorder: flush failed");
+            }
+        }
+
+        // std::ofstream has no descriptor to fsync, so sync the file through a second one.
+        int fd = ::open(path_.c_str(), O_WRONLY);
+        if (fd < 0 || ::fsync(fd) != 0) {
+            if (fd >= 0) {
+                ::close(fd);
+            }
+            logger_.error("TelemetryRecorder fsync failed: " + path_.string());
+            throw std::runtime_error("TelemetryRecorder: fsync failed");
+        }
+        ::close(fd);
+
+        logger_.info("TelemetryRecorder flushed and synced queued records");
+    }
+
+    std::uint16_t TelemetryRecorder::flags() const noexcept {
+        return static_cast<std::uint16_t>((indexing_ ? format::kFlagIndexed : 0) |
+                                          (blocks_ ? format::kFlagBlockCompressed : 0) | payload_flags_);
+    }
+
+    std::uint64_t TelemetryRecorder::record_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return record_count_;
+    }
+
+    TelemetryRecorder::Stats TelemetryRecorder::stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Stats s = stats_;
+        s.queued_bytes = static_cast<std::size_t>(accepted_bytes_ - written_bytes_);
+        return s;
     }
 
 }
\ No newline at end of file
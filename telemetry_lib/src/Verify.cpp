@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "telemetry/MappedFile.h"
+#include "telemetry/RecordFraming.h"
+#include "telemetry/TelemetryFormat.h"
+#include "telemetry/Verify.h"
+
+namespace telemetry {
+
+    namespace {
+
+        // Range of whole records handed to one worker.
+        struct Chunk {
+            std::size_t begin = 0;
+            std::size_t end = 0;
+            std::uint64_t first_record = 0;
+        };
+
+        struct ChunkResult {
+            std::uint64_t bad_records = 0;
+            std::uint64_t first_bad_record = std::numeric_limits<std::uint64_t>::max();
+            std::size_t first_bad_offset = 0;
+
+            // Block mode: record numbers above are chunk-relative until the
+            // per-chunk record counts are known
+            std::uint64_t records = 0;
+            std::uint64_t bad_blocks = 0;
+            std::string block_error;
+            std::size_t block_error_offset = 0;
+            std::uint64_t block_error_record = std::numeric_limits<std::uint64_t>::max();
+        };
+
+        // Chunks are small enough to balance the pool but large enough that
+        // claiming one costs nothing next to checksumming it.
+        constexpr std::size_t kMinChunkBytes = 256 * 1024;
+        constexpr std::size_t kChunksPerThread = 8;
+
+        void verify_chunk(std::span<const std::uint8_t> data,
+                          std::size_t max_packet_size,
+                          const Chunk& chunk,
+                          ChunkResult& result) {
+            std::size_t offset = chunk.begin;
+            std::uint64_t record = chunk.first_record;
+            RecordView view;
+            // Framing was validated by the walk, so frame_record cannot throw here
+            while (offset < chunk.end && frame_record(data.subspan(offset), max_packet_size, view)) {
+                if (!record_crc_ok(view)) {
+                    if (result.bad_records == 0) {
+                        result.first_bad_record = record;
+                        result.first_bad_offset = offset;
+                    }
+                    result.bad_records++;
+                }
+                offset += view.record_bytes;
+                record++;
+            }
+        }
+
+        void verify_block_chunk(std::span<const std::uint8_t> data,
+                                std::size_t max_packet_size,
+                                const Chunk& chunk,
+                                ChunkResult& result) {
+            std::vector<std::uint8_t> raw;
+            std::size_t offset = chunk.begin;
+            BlockView block;
+            // Block framing was validated by the walk; the contents are checked here
+            while (offset < chunk.end && frame_block(data.subspan(offset), max_packet_size, block)) {
+                try {
+                    decode_block(block, raw);
+                    std::span<const std::uint8_t> rest(raw);
+                    RecordView view;
+                    while (frame_record(rest, max_packet_size, view)) {
+                        if (!record_crc_ok(view)) {
+                            if (result.bad_records == 0) {
+                                result.first_bad_record = result.records;
+                                result.first_bad_offset = offset;
+                            }
+                            result.bad_records++;
+                        }
+                        rest = rest.subspan(view.record_bytes);
+                        result.records++;
+                    }
+                } catch (const ParseError& e) {
+                    if (result.bad_blocks == 0) {
+                        result.block_error = e.what();
+                        result.block_error_offset = offset;
+                        result.block_error_record = result.records;
+                    }
+                    result.bad_blocks++;
+                }
+                offset += block.block_bytes;
+            }
+        }
+
+    } // namespace
+
+    double VerifyReport::throughput_mb_s() const noexcept {
+        double seconds = std::chrono::duration<double>(elapsed).count();
+        return seconds > 0.0 ? static_cast<double>(bytes) / seconds / 1e6 : 0.0;
+    }
+
+    VerifyReport verify_recording(const std::filesystem::path& path,
+                                  VerifyOptions opt,
+                                  telemetry::Logger& logger) {
+        using clock = std::chrono::steady_clock;
+        auto start = clock::now();
+
+        VerifyReport report;
+        report.threads = opt.threads != 0 ? opt.threads : std::max(1u, std::thread::hardware_concurrency());
+
+        auto finish = [&]() -> VerifyReport {
+            report.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start);
+            if (report.ok()) {
+                logger.info("verify OK: " + path.string() + " | records=" + std::to_string(report.records) +
+                            " | bytes=" + std::to_string(report.bytes));
+            } else {
+                logger.error("verify FAILED: " + path.string() + " | " + report.error +
+                             " at offset " + std::to_string(report.error_offset) +
+                             " | bad_records=" + std::to_string(report.bad_records));
+            }
+            return report;
+        };
+
+        MappedFile file;
+        try {
+            file = MappedFile::open(path);
+        } catch (const std::runtime_error&) {
+            report.error = "failed to open telemetry file";
+            return finish();
+        }
+
+        FileHeader header;
+        try {
+            header = parse_header(file.bytes());
+        } catch (const ParseError& e) {
+            report.error = e.what();
+            return finish();
+        }
+
+        std::size_t data_end = file.size();
+        if (header.flags & format::kFlagIndexed) {
+            IndexTrailer trailer;
+            std::vector<IndexEntry> entries;
+            data_end = load_index_footer(file.bytes(), trailer, entries);
+        }
+        const auto data = file.bytes().first(data_end);
+        const bool blocks = (header.flags & format::kFlagBlockCompressed) != 0;
+
+        // ---- Sequential walk over the size fields: chunk boundaries + framing errors ----
+        const std::size_t chunk_target = std::max(kMinChunkBytes,
+            data.size() / (static_cast<std::size_t>(report.threads) * kChunksPerThread));
+
+        std::vector<Chunk> chunks;
+        std::string framing_error;
+        std::size_t offset = format::kHeaderSize;
+        Chunk current{offset, offset, 0};
+        RecordView view;
+        BlockView block;
+        while (true) {
+            try {
+                if (blocks) {
+                    if (!frame_block(data.subspan(offset), opt.max_packet_size, block)) {
+                        break;
+                    }
+                } else if (!frame_record(data.subspan(offset), opt.max_packet_size, view)) {
+                    break;
+                }
+            } catch (const ParseError& e) {
+                framing_error = e.what();
+                break;
+            }
+            if (blocks) {
+                offset += block.block_bytes;
+            } else {
+                offset += view.record_bytes;
+                report.records++;
+            }
+            if (offset - current.begin >= chunk_target) {
+                current.end = offset;
+                chunks.push_back(current);
+                current = Chunk{offset, offset, report.records};
+            }
+        }
+        if (offset > current.begin) {
+            current.end = offset;
+            chunks.push_back(current);
+        }
+        report.bytes = offset - format::kHeaderSize;
+
+        // ---- Parallel CRC check ----
+        std::vector<ChunkResult> results(chunks.size());
+        std::atomic<std::size_t> next_chunk{0};
+        auto work = [&]() {
+            for (std::size_t i = next_chunk.fetch_add(1); i < chunks.size(); i = next_chunk.fetch_add(1)) {
+                if (blocks) {
+                    verify_block_chunk(data, opt.max_packet_size, chunks[i], results[i]);
+                } else {
+                    verify_chunk(data, opt.max_packet_size, chunks[i], results[i]);
+                }
+            }
+        };
+
+        std::size_t helpers = std::min<std::size_t>(report.threads, chunks.size());
+        helpers = helpers > 0 ? helpers - 1 : 0; // the calling thread works too
+        std::vector<std::thread> pool;
+        pool.reserve(helpers);
+        for (std::size_t i = 0; i < helpers; i++) {
+            pool.emplace_back(work);
+        }
+        work();
+        for (auto& t : pool) {
+            t.join();
+        }
+
+        // ---- First error in file order ----
+        // A CRC mismatch always precedes the framing error (the walk stops there).
+        for (auto& r : results) {
+            if (blocks) {
+                // Records are only counted once their blocks are decoded
+                if (r.bad_records != 0) {
+                    r.first_bad_record += report.records;
+                }
+                if (r.bad_blocks != 0) {
+                    r.block_error_record += report.records;
+                    if (report.error.empty() && r.block_error_record <= r.first_bad_record) {
+                        report.error = r.block_error;
+                        report.error_offset = r.block_error_offset;
+                        report.error_record = r.block_error_record;
+                    }
+                }
+                report.records += r.records;
+                report.bad_blocks += r.bad_blocks;
+            }
+            if (r.bad_records != 0 && report.error.empty()) {
+                report.error = "incorrect CRC";
+                report.error_offset = r.first_bad_offset;
+                report.error_record = r.first_bad_record;
+            }
+            report.bad_records += r.bad_records;
+        }
+        if (report.error.empty() && !framing_error.empty()) {
+            report.error = framing_error;
+            report.error_offset = offset;
+            report.error_record = report.records;
+        }
+
+        return finish();
+    }
+
+} // namespace telemetry